@@ -0,0 +1,82 @@
+#include "s21_matrix_async.h"
+
+#include <algorithm>
+
+// S21Executor
+
+S21Executor::S21Executor(int threads) {
+  for (int i = 0; i < threads; ++i) {
+    workers_.emplace_back(&S21Executor::WorkerLoop, this);
+  }
+}
+
+S21Executor::~S21Executor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  for (std::thread &worker : workers_) worker.join();
+}
+
+S21Executor &S21Executor::Instance() {
+  // At least two workers, so that a caller blocking on Get() inside a task
+  // cannot starve the pipeline on a single-core host.
+  static S21Executor executor(
+      std::max(2, static_cast<int>(std::thread::hardware_concurrency())));
+  return executor;
+}
+
+void S21Executor::Submit(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void S21Executor::WorkerLoop() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+      if (queue_.empty()) return;
+      task = std::move(queue_.front());
+      queue_.pop_front();
+    }
+    task();
+  }
+}
+
+// Matrix operations
+
+S21Future<S21Matrix> MulMatrixAsync(S21Matrix a, S21Matrix b) {
+  return MulMatrixAsync(S21MakeReady(std::move(a)),
+                        S21MakeReady(std::move(b)));
+}
+
+S21Future<S21Matrix> MulMatrixAsync(S21Future<S21Matrix> a,
+                                    S21Future<S21Matrix> b) {
+  return S21Submit(
+      [](const S21Matrix &left, const S21Matrix &right) {
+        return left * right;
+      },
+      a, b);
+}
+
+S21Future<S21Matrix> InverseAsync(S21Matrix a) {
+  return InverseAsync(S21MakeReady(std::move(a)));
+}
+
+S21Future<S21Matrix> InverseAsync(S21Future<S21Matrix> a) {
+  return a.Then([](const S21Matrix &matrix) { return matrix.InverseMatrix(); });
+}
+
+S21Future<double> DeterminantAsync(S21Matrix a) {
+  return DeterminantAsync(S21MakeReady(std::move(a)));
+}
+
+S21Future<double> DeterminantAsync(S21Future<S21Matrix> a) {
+  return a.Then([](const S21Matrix &matrix) { return matrix.Determinant(); });
+}
@@ -0,0 +1,200 @@
+#ifndef S21_MATRIX_ASYNC_H
+#define S21_MATRIX_ASYNC_H
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Пул потоков библиотеки. Задачи не блокируются в ожидании друг друга:
+// зависимые задачи ставятся в очередь только после готовности входов.
+class S21Executor {
+ public:
+  explicit S21Executor(int threads);
+  ~S21Executor();
+  S21Executor(const S21Executor &) = delete;
+  S21Executor &operator=(const S21Executor &) = delete;
+
+  static S21Executor &Instance();
+  void Submit(std::function<void()> task);
+
+ private:
+  void WorkerLoop();
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> queue_;
+  std::vector<std::thread> workers_;
+  bool stop_ = false;
+};
+
+// Общее состояние пары S21Promise / S21Future
+template <typename T>
+class S21FutureState {
+ public:
+  void SetValue(T value) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    value_.emplace(std::move(value));
+    Finish(lock);
+  }
+
+  void SetError(std::exception_ptr error) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    error_ = error;
+    Finish(lock);
+  }
+
+  bool IsReady() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ready_;
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return ready_; });
+  }
+
+  const T &Get() {
+    Wait();
+    if (error_) std::rethrow_exception(error_);
+    return *value_;
+  }
+
+  void OnReady(std::function<void()> callback) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!ready_) {
+      callbacks_.push_back(std::move(callback));
+      return;
+    }
+    lock.unlock();
+    callback();
+  }
+
+ private:
+  void Finish(std::unique_lock<std::mutex> &lock) {
+    ready_ = true;
+    std::vector<std::function<void()>> callbacks;
+    callbacks.swap(callbacks_);
+    lock.unlock();
+    cv_.notify_all();
+    for (auto &callback : callbacks) callback();
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool ready_ = false;
+  std::optional<T> value_;
+  std::exception_ptr error_;
+  std::vector<std::function<void()>> callbacks_;
+};
+
+template <typename T>
+class S21Promise;
+
+// Результат асинхронной операции
+template <typename T>
+class S21Future {
+ public:
+  S21Future() = default;
+
+  bool Valid() const { return state_ != nullptr; }
+  bool IsReady() const { return state_->IsReady(); }
+  void Wait() const { state_->Wait(); }
+  // Ссылка действительна, пока жив хотя бы один S21Future этой операции
+  const T &Get() const { return state_->Get(); }
+
+  // callback вызывается один раз в потоке, завершившем операцию
+  void OnReady(std::function<void()> callback) const {
+    state_->OnReady(std::move(callback));
+  }
+
+  // Ставит fn(Get()) в очередь после готовности этого результата
+  template <typename F>
+  auto Then(F fn) const;
+
+ private:
+  friend class S21Promise<T>;
+  explicit S21Future(std::shared_ptr<S21FutureState<T>> state)
+      : state_(std::move(state)) {}
+
+  std::shared_ptr<S21FutureState<T>> state_;
+};
+
+template <typename T>
+class S21Promise {
+ public:
+  S21Promise() : state_(std::make_shared<S21FutureState<T>>()) {}
+
+  S21Future<T> GetFuture() const { return S21Future<T>(state_); }
+  void SetValue(T value) const { state_->SetValue(std::move(value)); }
+  void SetError(std::exception_ptr error) const { state_->SetError(error); }
+
+ private:
+  std::shared_ptr<S21FutureState<T>> state_;
+};
+
+template <typename T>
+S21Future<T> S21MakeReady(T value) {
+  S21Promise<T> promise;
+  promise.SetValue(std::move(value));
+  return promise.GetFuture();
+}
+
+// Вызывает callback, когда готовы все перечисленные результаты
+inline void S21WhenAll(std::function<void()> callback) { callback(); }
+
+template <typename T, typename... Rest>
+void S21WhenAll(std::function<void()> callback, const S21Future<T> &first,
+                const S21Future<Rest> &...rest) {
+  first.OnReady([callback, rest...]() { S21WhenAll(callback, rest...); });
+}
+
+// Выполняет fn(deps.Get()...) в пуле после готовности всех deps.
+// Ошибка любой зависимости или самой fn передается в результат.
+template <typename F, typename... Ts>
+auto S21Submit(F fn, S21Future<Ts>... deps)
+    -> S21Future<std::invoke_result_t<F, const Ts &...>> {
+  using Result = std::invoke_result_t<F, const Ts &...>;
+  static_assert(!std::is_void_v<Result>, "Task must return a value");
+
+  S21Promise<Result> promise;
+  S21Future<Result> future = promise.GetFuture();
+  S21WhenAll(
+      [promise, fn, deps...]() {
+        S21Executor::Instance().Submit([promise, fn, deps...]() mutable {
+          try {
+            promise.SetValue(fn(deps.Get()...));
+          } catch (...) {
+            promise.SetError(std::current_exception());
+          }
+        });
+      },
+      deps...);
+  return future;
+}
+
+template <typename T>
+template <typename F>
+auto S21Future<T>::Then(F fn) const {
+  return S21Submit(std::move(fn), *this);
+}
+
+// Асинхронные варианты операций над матрицами
+S21Future<S21Matrix> MulMatrixAsync(S21Matrix a, S21Matrix b);
+S21Future<S21Matrix> MulMatrixAsync(S21Future<S21Matrix> a,
+                                    S21Future<S21Matrix> b);
+S21Future<S21Matrix> InverseAsync(S21Matrix a);
+S21Future<S21Matrix> InverseAsync(S21Future<S21Matrix> a);
+S21Future<double> DeterminantAsync(S21Matrix a);
+S21Future<double> DeterminantAsync(S21Future<S21Matrix> a);
+
+#endif  // S21_MATRIX_ASYNC_H
@@ -0,0 +1,263 @@
+#include "s21_matrix_autotune.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+enum TuningState { kUntuned, kTuning, kTuned };
+
+std::atomic<int> g_state{kUntuned};
+
+double NowSeconds() {
+  using namespace std::chrono;
+  return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Best of three runs, in seconds.
+double Time(const std::function<void()>& run) {
+  double best = std::numeric_limits<double>::max();
+  for (int r = 0; r < 3; ++r) {
+    double start = NowSeconds();
+    run();
+    best = std::min(best, NowSeconds() - start);
+  }
+  return best;
+}
+
+S21Matrix Filled(int rows, int cols) {
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    double* row = matrix.RowData(i);
+    for (int j = 0; j < cols; ++j) row[j] = ((i * 31 + j * 17) % 97) / 97.0;
+  }
+  return matrix;
+}
+
+// Picks the candidate with the lowest time; apply installs a candidate
+// into params before it is timed.
+template <typename T>
+T Fastest(const std::vector<T>& candidates, S21TuningParams& params,
+          const std::function<void(S21TuningParams&, T)>& apply,
+          const std::function<void()>& run) {
+  T best = candidates.front();
+  double best_time = std::numeric_limits<double>::max();
+  for (T candidate : candidates) {
+    apply(params, candidate);
+    S21Matrix::SetTuning(params);
+    double time = Time(run);
+    if (time < best_time) {
+      best_time = time;
+      best = candidate;
+    }
+  }
+  apply(params, best);
+  S21Matrix::SetTuning(params);
+  return best;
+}
+
+// Smallest work, among sizes, at which running on all threads beats one
+// thread. work(n) is the work the kernel reports for size n. The n x n
+// operand is filled once per size, so only the kernel itself is timed;
+// its setup would otherwise dilute the speedup and raise the threshold.
+double Crossover(const std::vector<int>& sizes,
+                 const std::function<double(int)>& work,
+                 const std::function<void(S21Matrix&)>& run,
+                 S21TuningParams& params,
+                 double S21TuningParams::*threshold) {
+  for (int n : sizes) {
+    S21Matrix x = Filled(n, n);
+    params.*threshold = std::numeric_limits<double>::max();
+    S21Matrix::SetTuning(params);
+    double serial = Time([&] { run(x); });
+    params.*threshold = 0.0;
+    S21Matrix::SetTuning(params);
+    double parallel = Time([&] { run(x); });
+    if (parallel < serial) return work(n);
+  }
+  return work(sizes.back()) * 2;
+}
+
+}  // namespace
+
+void S21Autotuner::EnsureTuned() {
+  if (g_state.load(std::memory_order_acquire) == kTuned) return;
+  // Calls made while tuning is in progress, including the benchmarks
+  // themselves, run with the current parameters instead of waiting.
+  int expected = kUntuned;
+  if (!g_state.compare_exchange_strong(expected, kTuning)) return;
+
+  const char* mode = std::getenv("S21_MATRIX_AUTOTUNE");
+  if (mode != nullptr && std::strcmp(mode, "0") != 0 && mode[0] != '\0') {
+    std::string path = CachePath();
+    if (!Load(path)) Save(path, Tune());
+  }
+  g_state.store(kTuned, std::memory_order_release);
+}
+
+S21TuningParams S21Autotuner::Tune(int size) {
+  // An explicit call counts as tuning, so the benchmarks below do not
+  // start another one through EnsureTuned.
+  int state = kUntuned;
+  g_state.compare_exchange_strong(state, kTuning);
+
+  size = std::max(size, 32);
+  S21TuningParams params = S21Matrix::GetTuning();
+
+  S21Matrix a = Filled(size, size);
+  S21Matrix b = Filled(size, size);
+  std::vector<int> mul_blocks;
+  for (int block = 16; block <= std::min(size, 256); block *= 2) {
+    mul_blocks.push_back(block);
+  }
+  Fastest<int>(
+      mul_blocks, params,
+      [](S21TuningParams& p, int block) { p.mul_block = block; },
+      [&] { S21Matrix product = a * b; });
+
+  S21Matrix wide = Filled(2 * size, 2 * size);
+  Fastest<int>(
+      {8, 16, 32, 64, 128}, params,
+      [](S21TuningParams& p, int block) { p.transpose_block = block; },
+      [&] { S21Matrix transposed = wide.Transpose(); });
+
+  if (S21Matrix::GetMaxThreads() > 1) {
+    std::vector<int> mul_sizes;
+    for (int n = 32; n <= size; n += n / 2) mul_sizes.push_back(n);
+    params.parallel_work = Crossover(
+        mul_sizes, [](int n) { return 1.0 * n * n * n; },
+        [](S21Matrix& x) { S21Matrix product = x * x; },
+        params, &S21TuningParams::parallel_work);
+
+    std::vector<int> sum_sizes;
+    for (int n = 64; n <= 4 * size; n *= 2) sum_sizes.push_back(n);
+    params.elementwise_work = Crossover(
+        sum_sizes, [](int n) { return 1.0 * n * n; },
+        [](S21Matrix& x) {
+          for (int r = 0; r < 4; ++r) x.SumMatrix(x);
+        },
+        params, &S21TuningParams::elementwise_work);
+  }
+  S21Matrix::SetTuning(params);
+  if (state == kUntuned) g_state.store(kTuned, std::memory_order_release);
+  return params;
+}
+
+bool S21Autotuner::Load(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) return false;
+  const std::string key = CpuKey();
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.compare(0, key.size() + 1, key + '\t') != 0) continue;
+    S21TuningParams params;
+    std::istringstream values(line.substr(key.size() + 1));
+    if (!(values >> params.mul_block >> params.transpose_block >>
+          params.parallel_work >> params.elementwise_work) ||
+        params.mul_block < 1 || params.transpose_block < 1) {
+      return false;
+    }
+    S21Matrix::SetTuning(params);
+    return true;
+  }
+  return false;
+}
+
+bool S21Autotuner::Save(const std::string& path,
+                        const S21TuningParams& params) {
+  const std::string key = CpuKey();
+  std::vector<std::string> lines;
+  {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.compare(0, key.size() + 1, key + '\t') != 0) {
+        lines.push_back(line);
+      }
+    }
+  }
+  std::ostringstream entry;
+  entry.precision(17);
+  entry << key << '\t' << params.mul_block << ' ' << params.transpose_block
+        << ' ' << params.parallel_work << ' ' << params.elementwise_work;
+  lines.push_back(entry.str());
+
+  std::string contents;
+  for (const std::string& line : lines) contents += line + '\n';
+
+  // Written to a uniquely named file next to the cache and renamed over it,
+  // so concurrent readers never see a partial file and concurrent writers
+  // never share a temporary.
+  std::error_code error;
+  std::filesystem::path target(path);
+  if (target.has_parent_path()) {
+    std::filesystem::create_directories(target.parent_path(), error);
+  }
+  std::string temporary = path + ".XXXXXX";
+  int fd = mkstemp(&temporary[0]);
+  if (fd < 0) return false;
+  const char* data = contents.data();
+  size_t left = contents.size();
+  while (left > 0) {
+    ssize_t written = write(fd, data, left);
+    if (written < 0 && errno == EINTR) continue;
+    if (written <= 0) break;
+    data += written;
+    left -= static_cast<size_t>(written);
+  }
+  if (close(fd) != 0 || left > 0) {
+    std::remove(temporary.c_str());
+    return false;
+  }
+  std::filesystem::rename(temporary, target, error);
+  if (error) std::remove(temporary.c_str());
+  return !error;
+}
+
+std::string S21Autotuner::CachePath() {
+  if (const char* path = std::getenv("S21_MATRIX_TUNE_CACHE")) return path;
+  if (const char* cache = std::getenv("XDG_CACHE_HOME")) {
+    return std::string(cache) + "/s21_matrix_tune";
+  }
+  if (const char* home = std::getenv("HOME")) {
+    return std::string(home) + "/.cache/s21_matrix_tune";
+  }
+  return "s21_matrix_tune";
+}
+
+std::string S21Autotuner::CpuKey() {
+  static const std::string key = [] {
+    std::string model = "unknown";
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line)) {
+      if (line.compare(0, 10, "model name") == 0 ||
+          line.compare(0, 9, "Processor") == 0) {
+        size_t colon = line.find(':');
+        size_t value = colon == std::string::npos
+                           ? colon
+                           : line.find_first_not_of(" \t", colon + 1);
+        if (value != std::string::npos) {
+          model = line.substr(value);
+          break;
+        }
+      }
+    }
+    return model + " x" + std::to_string(std::thread::hardware_concurrency());
+  }();
+  return key;
+}
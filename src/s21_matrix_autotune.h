@@ -0,0 +1,27 @@
+#ifndef S21_MATRIX_AUTOTUNE_H
+#define S21_MATRIX_AUTOTUNE_H
+
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+// Подбор S21TuningParams под процессор. При S21_MATRIX_AUTOTUNE=1 первый
+// вызов настраиваемого ядра загружает параметры из файла кэша, а если для
+// этого процессора записи нет - измеряет их и сохраняет. Путь к файлу
+// задается S21_MATRIX_TUNE_CACHE, по умолчанию ~/.cache/s21_matrix_tune.
+class S21Autotuner {
+ public:
+  // Вызывается ядрами S21Matrix; после первого вызова ничего не делает
+  static void EnsureTuned();
+  // Измеряет кандидатов на матрицах порядка size и применяет лучших
+  static S21TuningParams Tune(int size = 256);
+  // Применяет параметры этого процессора из файла, false - записи нет
+  static bool Load(const std::string &path);
+  // Записывает параметры этого процессора, сохраняя записи остальных
+  static bool Save(const std::string &path, const S21TuningParams &params);
+  static std::string CachePath();
+  // Ключ записи в кэше: модель процессора и число аппаратных потоков
+  static std::string CpuKey();
+};
+
+#endif  // S21_MATRIX_AUTOTUNE_H
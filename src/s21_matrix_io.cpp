@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_profile.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Separator that selects the whitespace-delimited format.
+constexpr char kWhitespace = ' ';
+
+// Inputs are split into per-thread chunks of at least this many bytes.
+constexpr size_t kMinChunkBytes = size_t(1) << 18;
+
+// Longest shortest-round-trip representation of a double is 24 characters.
+constexpr size_t kMaxNumberChars = 32;
+
+// Read-only view of a whole file, mapped where possible.
+class InputFile {
+ public:
+  explicit InputFile(const std::string& path) {
+#ifdef __linux__
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Cannot open file " + path);
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+      size_ = static_cast<size_t>(info.st_size);
+      void* memory = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (memory != MAP_FAILED) {
+        madvise(memory, size_, MADV_SEQUENTIAL);
+        mapped_ = static_cast<const char*>(memory);
+      }
+    }
+    close(fd);
+    if (mapped_ != nullptr || size_ == 0) return;
+#endif
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open file " + path);
+    buffer_.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+    size_ = buffer_.size();
+  }
+
+  ~InputFile() {
+#ifdef __linux__
+    if (mapped_ != nullptr) munmap(const_cast<char*>(mapped_), size_);
+#endif
+  }
+
+  InputFile(const InputFile &) = delete;
+  InputFile& operator=(const InputFile &) = delete;
+
+  const char* Data() const {
+    return mapped_ != nullptr ? mapped_ : buffer_.data();
+  }
+  size_t Size() const { return size_; }
+
+ private:
+  const char* mapped_ = nullptr;
+  std::vector<char> buffer_;
+  size_t size_ = 0;
+};
+
+// Skips spaces, tabs and carriage returns, except a blank that is itself
+// the delimiter, so that tab-separated files keep their separators.
+const char* SkipBlanks(const char* p, const char* end, char delimiter) {
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r') &&
+         (*p != delimiter || delimiter == kWhitespace)) {
+    ++p;
+  }
+  return p;
+}
+
+// Parses the values of one line [p, end). The first capacity values are
+// stored in out. Returns the number of values, 0 for a blank line and -1
+// for malformed input.
+int ParseLine(const char* p, const char* end, char delimiter, double* out,
+              int capacity) {
+  int count = 0;
+  p = SkipBlanks(p, end, delimiter);
+  if (p == end) return 0;
+  for (;;) {
+    if (p < end && *p == '+') ++p;
+    double value;
+    std::from_chars_result parsed = std::from_chars(p, end, value);
+    if (parsed.ec != std::errc()) return -1;
+    if (count < capacity) out[count] = value;
+    ++count;
+    p = SkipBlanks(parsed.ptr, end, delimiter);
+    if (p == end) return count;
+    if (delimiter == kWhitespace) {
+      // A value must be followed by a blank.
+      if (p == parsed.ptr) return -1;
+    } else if (*p++ != delimiter) {
+      return -1;
+    } else {
+      p = SkipBlanks(p, end, delimiter);
+    }
+  }
+}
+
+const char* LineEnd(const char* p, const char* end) {
+  const void* newline = std::memchr(p, '\n', end - p);
+  return newline != nullptr ? static_cast<const char*>(newline) : end;
+}
+
+// Splits [data, data + size) into at most threads chunks that start at
+// line boundaries. Returns threads + 1 boundaries.
+std::vector<const char*> SplitLines(const char* data, size_t size,
+                                     int threads) {
+  std::vector<const char*> bounds(threads + 1, data + size);
+  bounds[0] = data;
+  for (int t = 1; t < threads; ++t) {
+    const char* guess = std::max(bounds[t - 1], data + size * t / threads);
+    bounds[t] = guess == data ? data : LineEnd(guess - 1, data + size);
+    if (bounds[t] < data + size) ++bounds[t];
+  }
+  return bounds;
+}
+
+// Runs body(t) for t in [0, threads) and rethrows the first exception.
+template <typename Body>
+void RunChunks(int threads, const Body& body) {
+  std::vector<std::exception_ptr> errors(threads);
+  std::vector<std::thread> workers;
+  workers.reserve(threads - 1);
+  auto guarded = [&](int t) {
+    try {
+      body(t);
+    } catch (...) {
+      errors[t] = std::current_exception();
+    }
+  };
+  for (int t = 1; t < threads; ++t) workers.emplace_back(guarded, t);
+  guarded(0);
+  for (std::thread& worker : workers) worker.join();
+  for (const std::exception_ptr& error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+
+int ChunkCount(size_t bytes) {
+  size_t by_size = std::max<size_t>(bytes / kMinChunkBytes, 1);
+  return static_cast<int>(
+      std::min<size_t>(S21Matrix::GetMaxThreads(), by_size));
+}
+
+}  // namespace
+
+// Text import and export
+
+S21Matrix S21Matrix::FromCsv(const std::string& path, char delimiter) {
+  InputFile file(path);
+  const char* data = file.Data();
+  const size_t size = file.Size();
+  S21_PROFILE_SCOPE("FromCsv", 0, 0, 0.0, 1.0 * size);
+
+  // The first non-blank line fixes the number of columns.
+  int cols = 0;
+  for (const char* p = data, *end = data + size; p < end && cols == 0;) {
+    const char* line_end = LineEnd(p, end);
+    cols = ParseLine(p, line_end, delimiter, nullptr, 0);
+    if (cols < 0) throw std::invalid_argument("Invalid matrix data");
+    p = line_end + 1;
+  }
+  if (cols == 0) throw std::invalid_argument("Invalid matrix size");
+
+  // Pass 1 counts the rows of every chunk, pass 2 parses each chunk
+  // straight into its rows of the result.
+  const int threads = ChunkCount(size);
+  std::vector<const char*> bounds = SplitLines(data, size, threads);
+  std::vector<int> first_row(threads + 1, 0);
+  RunChunks(threads, [&](int t) {
+    int rows = 0;
+    for (const char* p = bounds[t]; p < bounds[t + 1];) {
+      const char* line_end = LineEnd(p, bounds[t + 1]);
+      if (SkipBlanks(p, line_end, delimiter) != line_end) ++rows;
+      p = line_end + 1;
+    }
+    first_row[t + 1] = rows;
+  });
+  for (int t = 0; t < threads; ++t) first_row[t + 1] += first_row[t];
+
+  S21Matrix result(first_row[threads], cols, S21Uninitialized);
+  RunChunks(threads, [&](int t) {
+    int row = first_row[t];
+    for (const char* p = bounds[t]; p < bounds[t + 1];) {
+      const char* line_end = LineEnd(p, bounds[t + 1]);
+      // Pass 1 guarantees a row for every non-blank line; trailing blank
+      // lines see no row.
+      const bool has_row = row < first_row[t + 1];
+      int count = ParseLine(p, line_end, delimiter,
+                            has_row ? result.matrix_[row] : nullptr,
+                            has_row ? cols : 0);
+      if (count > 0) ++row;
+      if (count != 0 && count != cols) {
+        throw std::invalid_argument("Invalid matrix data");
+      }
+      p = line_end + 1;
+    }
+  });
+  return result;
+}
+
+S21Matrix S21Matrix::FromText(const std::string& path) {
+  return FromCsv(path, kWhitespace);
+}
+
+void S21Matrix::ToCsv(const std::string& path, char delimiter) const {
+  S21_PROFILE_SCOPE("ToCsv", rows_, cols_, 0.0, 8.0 * rows_ * cols_);
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) throw std::runtime_error("Cannot open file " + path);
+
+  // Rows are formatted in parallel into one buffer per chunk and written
+  // in order.
+  const size_t row_bytes = static_cast<size_t>(cols_) * kMaxNumberChars;
+  const int threads = ChunkCount(row_bytes * rows_);
+  std::vector<std::vector<char>> chunks(threads);
+  RunChunks(threads, [&](int t) {
+    const int begin = static_cast<int>(1LL * rows_ * t / threads);
+    const int end = static_cast<int>(1LL * rows_ * (t + 1) / threads);
+    std::vector<char>& text = chunks[t];
+    text.resize(row_bytes * (end - begin));
+    char* out = text.data();
+    for (int i = begin; i < end; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        if (j > 0) *out++ = delimiter;
+        out = std::to_chars(out, out + kMaxNumberChars - 1, matrix_[i][j])
+                  .ptr;
+      }
+      *out++ = '\n';
+    }
+    text.resize(out - text.data());
+  });
+
+  bool written = true;
+  for (const std::vector<char>& text : chunks) {
+    written = written &&
+              std::fwrite(text.data(), 1, text.size(), file) == text.size();
+  }
+  if (std::fclose(file) != 0 || !written) {
+    throw std::runtime_error("Cannot write file " + path);
+  }
+}
+
+void S21Matrix::ToText(const std::string& path) const {
+  ToCsv(path, kWhitespace);
+}
@@ -1,51 +1,709 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <new>
+#include <thread>
+
+#include "s21_matrix_autotune.h"
+#include "s21_matrix_profile.h"
+#include "s21_small_kernels.h"
+#include "s21_tiled_factorization.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+// Buffers of at least one huge page are mapped directly so that the kernel
+// can back them with transparent huge pages and place every page on the
+// NUMA node of the thread that first writes it.
+constexpr size_t kHugePageBytes = size_t(2) << 20;
+constexpr size_t kMapThresholdBytes = kHugePageBytes;
+
+// Square matrices from this size on are factorized by the tiled LU.
+constexpr int kTiledThreshold = 256;
+constexpr int kTileSize = 64;
+
+std::atomic<int> g_max_threads{0};
+// Current S21TuningParams, see S21Matrix::SetTuning.
+std::atomic<int> g_mul_block{S21TuningParams{}.mul_block};
+std::atomic<int> g_transpose_block{S21TuningParams{}.transpose_block};
+std::atomic<double> g_parallel_work{S21TuningParams{}.parallel_work};
+std::atomic<double> g_elementwise_work{S21TuningParams{}.elementwise_work};
+std::atomic<bool> g_copy_on_write{false};
+std::atomic<bool> g_pin_threads{false};
+
+bool IsMapped(size_t count) {
+#ifdef __linux__
+  return count * sizeof(double) >= kMapThresholdBytes;
+#else
+  (void)count;
+  return false;
+#endif
+}
+
+#ifdef __linux__
+// Mapped buffers span whole huge pages.
+size_t MappedBytes(size_t count) {
+  size_t bytes = count * sizeof(double);
+  return (bytes + kHugePageBytes - 1) / kHugePageBytes * kHugePageBytes;
+}
+
+// mmap only aligns to the base page size, and transparent huge pages can
+// back only 2 MiB aligned ranges, so the mapping is over-allocated by one
+// huge page and trimmed to an aligned start.
+void* MapHugeAligned(size_t bytes) {
+  const size_t span = bytes + kHugePageBytes;
+  void* memory = mmap(nullptr, span, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (memory == MAP_FAILED) throw std::bad_alloc();
+  char* raw = static_cast<char*>(memory);
+  const size_t misalignment = reinterpret_cast<uintptr_t>(raw) % kHugePageBytes;
+  const size_t head = misalignment == 0 ? 0 : kHugePageBytes - misalignment;
+  if (head > 0) munmap(raw, head);
+  munmap(raw + head + bytes, span - head - bytes);
+#ifdef MADV_HUGEPAGE
+  madvise(raw + head, bytes, MADV_HUGEPAGE);
+#endif
+  return raw + head;
+}
+#endif
+
+double* AllocateBuffer(size_t count) {
+  S21_PROFILE_ALLOCATION();
+#ifdef __linux__
+  if (IsMapped(count)) {
+    return static_cast<double*>(MapHugeAligned(MappedBytes(count)));
+  }
+#endif
+  return new double[count];
+}
+
+void ReleaseBuffer(double* data, size_t count) {
+#ifdef __linux__
+  if (IsMapped(count)) {
+    munmap(data, MappedBytes(count));
+    return;
+  }
+#endif
+  delete[] data;
+}
+
+// Returns a buffer of new_count elements that starts with the first used
+// elements of data, and releases data. Mapped buffers are grown with
+// mremap, which moves page table entries instead of copying elements, into
+// a huge-page aligned range reserved beforehand.
+double* GrowBuffer(double* data, size_t count, size_t used, size_t new_count) {
+#if defined(__linux__) && defined(MREMAP_MAYMOVE) && defined(MREMAP_FIXED)
+  if (IsMapped(count) && IsMapped(new_count)) {
+    const size_t bytes = MappedBytes(count);
+    const size_t new_bytes = MappedBytes(new_count);
+    if (new_bytes == bytes) return data;
+    S21_PROFILE_ALLOCATION();
+    void* target = MapHugeAligned(new_bytes);
+    void* memory = mremap(data, bytes, new_bytes,
+                          MREMAP_MAYMOVE | MREMAP_FIXED, target);
+    if (memory == MAP_FAILED) {
+      munmap(target, new_bytes);
+      throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(memory, new_bytes, MADV_HUGEPAGE);
+#endif
+    return static_cast<double*>(memory);
+  }
+#endif
+  double* grown = AllocateBuffer(new_count);
+  if (used > 0) std::memcpy(grown, data, used * sizeof(double));
+  ReleaseBuffer(data, count);
+  return grown;
+}
+
+int ThreadCount() {
+  int threads = g_max_threads.load(std::memory_order_relaxed);
+  if (threads <= 0) {
+    threads = static_cast<int>(std::thread::hardware_concurrency());
+  }
+  return std::max(threads, 1);
+}
+
+// Binds the calling worker to one of the CPUs the process may run on, or
+// back to all of them when pinned is false.
+void SetWorkerAffinity(int index, bool pinned) {
+#ifdef __linux__
+  static const std::vector<int> cpus = [] {
+    std::vector<int> allowed;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+      for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (CPU_ISSET(cpu, &set)) allowed.push_back(cpu);
+      }
+    }
+    return allowed;
+  }();
+  if (cpus.empty()) return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pinned) {
+    CPU_SET(cpus[index % cpus.size()], &set);
+  } else {
+    for (int cpu : cpus) CPU_SET(cpu, &set);
+  }
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  (void)index;
+  (void)pinned;
+#endif
+}
+
+// Persistent workers behind ForEachRowBlock. Block t of every call runs on
+// worker t, so the rows a worker first touches are the rows it processes
+// in later calls with the same shape. Workers are bound to CPUs only after
+// S21Matrix::SetPinThreads(true); otherwise the scheduler places them.
+class RowBlockPool {
+ public:
+  static RowBlockPool& Instance() {
+    static RowBlockPool pool;
+    return pool;
+  }
+
+  ~RowBlockPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+  }
+
+  static bool InWorker() { return in_worker_; }
+
+  // Runs body(t) on worker t for every t in [0, blocks) and waits for all
+  // of them. Calls from different threads take turns.
+  void Run(int blocks, const std::function<void(int)>& body) {
+    std::lock_guard<std::mutex> run_lock(run_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (static_cast<int>(workers_.size()) < blocks) {
+      workers_.emplace_back(&RowBlockPool::WorkerLoop, this,
+                            static_cast<int>(workers_.size()), generation_);
+    }
+    body_ = &body;
+    blocks_ = blocks;
+    pending_ = blocks;
+    ++generation_;
+    wake_.notify_all();
+    done_.wait(lock, [this] { return pending_ == 0; });
+    body_ = nullptr;
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    if (error) std::rethrow_exception(error);
+  }
+
+ private:
+  RowBlockPool() = default;
+
+  void WorkerLoop(int index, uint64_t seen) {
+    in_worker_ = true;
+    bool pinned = false;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+      if (index >= blocks_) continue;
+      const std::function<void(int)>* body = body_;
+      lock.unlock();
+      if (pinned != g_pin_threads.load(std::memory_order_relaxed)) {
+        pinned = !pinned;
+        SetWorkerAffinity(index, pinned);
+      }
+      std::exception_ptr error;
+      try {
+        (*body)(index);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      lock.lock();
+      if (error && !error_) error_ = error;
+      if (--pending_ == 0) done_.notify_one();
+    }
+  }
+
+  static thread_local bool in_worker_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  std::vector<std::thread> workers_;
+  const std::function<void(int)>* body_ = nullptr;
+  int blocks_ = 0;
+  int pending_ = 0;
+  uint64_t generation_ = 0;
+  std::exception_ptr error_;
+  bool stop_ = false;
+};
+
+thread_local bool RowBlockPool::in_worker_ = false;
+
+// Splits [0, rows) into one contiguous block per thread. Every row-parallel
+// kernel and the first-touch initialization go through here, so for a
+// given shape and thread count a row is always processed by the same
+// worker; with pinning enabled that worker also stays on the NUMA node
+// that holds the pages it first touched. Calls with less
+// work than threshold, and calls made from inside a block, run inline.
+void ForEachRowBlock(int rows, double work,
+                     const std::function<void(int, int)>& body,
+                     double threshold) {
+  // Moved-from matrices have no rows, and their row arrays must not be
+  // indexed.
+  if (rows <= 0) return;
+  int threads = std::min(ThreadCount(), rows);
+  if (threads <= 1 || work < threshold || RowBlockPool::InWorker()) {
+    body(0, rows);
+    return;
+  }
+
+  const int chunk = rows / threads;
+  const int extra = rows % threads;
+  RowBlockPool::Instance().Run(threads, [&](int t) {
+    int begin = t * chunk + std::min(t, extra);
+    body(begin, begin + chunk + (t < extra ? 1 : 0));
+  });
+}
+
+void ForEachRowBlock(int rows, double work,
+                     const std::function<void(int, int)>& body) {
+  ForEachRowBlock(rows, work, body,
+                  g_parallel_work.load(std::memory_order_relaxed));
+}
+
+double ElementwiseWork() {
+  return g_elementwise_work.load(std::memory_order_relaxed);
+}
+
+}  // namespace
+
 // Private
 
-void S21Matrix::AllocateMemory(int rows, int cols) {
+void S21Matrix::AllocateMemory(int rows, int cols, bool zero_fill) {
+  capacity_ = static_cast<size_t>(rows) * cols;
+  data_ = AllocateBuffer(capacity_);
+  refs_ = new std::atomic<int>(1);
   matrix_ = new double*[rows];
-  for (int i = 0; i < rows; ++i) {
-    matrix_[i] = new double[cols]();
+  row_capacity_ = rows;
+  S21_PROFILE_ALLOCATION();
+  BindRows();
+  if (zero_fill) {
+    ForEachRowBlock(rows, 1.0 * rows * cols, [&](int begin, int end) {
+      std::memset(matrix_[begin], 0,
+                  sizeof(double) * cols * static_cast<size_t>(end - begin));
+    });
   }
 }
 
 void S21Matrix::FreeMemory() {
-  for (int i = 0; i < rows_; ++i) {
-    delete[] matrix_[i];
-  }
   delete[] matrix_;
+  if (refs_->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete refs_;
+    ReleaseBuffer(data_, capacity_);
+  }
+  matrix_ = nullptr;
+  row_capacity_ = 0;
+  data_ = nullptr;
+  capacity_ = 0;
+  refs_ = nullptr;
+}
+
+void S21Matrix::BindRows(int first) {
+  for (int i = first; i < rows_; ++i) {
+    matrix_[i] = data_ + static_cast<size_t>(i) * cols_;
+  }
+}
+
+// Makes room for a rows x cols shape while keeping the current elements
+// in place. Expects a buffer that is not shared. Row pointers are rebound
+// only when a buffer moved, so growing by one row stays amortized O(cols).
+void S21Matrix::EnsureCapacity(int rows, int cols, bool exact) {
+  // A moved-from matrix owns nothing yet.
+  if (refs_ == nullptr) refs_ = new std::atomic<int>(1);
+  bool moved = false;
+  size_t needed = static_cast<size_t>(rows) * cols;
+  if (needed > capacity_) {
+    size_t grown = exact ? needed : std::max(needed, 2 * capacity_);
+    double* data = GrowBuffer(data_, capacity_,
+                              static_cast<size_t>(rows_) * cols_, grown);
+    moved = data != data_;
+    data_ = data;
+    capacity_ = grown;
+  }
+  if (rows > row_capacity_) {
+    int grown = exact ? rows : std::max(rows, 2 * row_capacity_);
+    delete[] matrix_;
+    matrix_ = new double*[grown];
+    S21_PROFILE_ALLOCATION();
+    row_capacity_ = grown;
+    moved = true;
+  }
+  if (moved) BindRows();
+}
+
+// Takes the shape and contents of other; expects no memory held. In
+// copy-on-write mode the element buffer is shared instead of copied, unless
+// a writable reference into it may still be held by a caller.
+void S21Matrix::CopyFrom(const S21Matrix& other) {
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  shareable_ = true;
+  // A moved-from matrix has no buffer to share.
+  if (!g_copy_on_write.load(std::memory_order_relaxed) ||
+      other.refs_ == nullptr || !other.shareable_) {
+    AllocateMemory(rows_, cols_, false);
+    ForEachRowBlock(rows_, 1.0 * rows_ * cols_, [&](int begin, int end) {
+      std::memcpy(matrix_[begin], other.matrix_[begin],
+                  sizeof(double) * cols_ * static_cast<size_t>(end - begin));
+    });
+    return;
+  }
+
+  other.refs_->fetch_add(1, std::memory_order_relaxed);
+  data_ = other.data_;
+  capacity_ = other.capacity_;
+  refs_ = other.refs_;
+  matrix_ = new double*[rows_];
+  row_capacity_ = rows_;
+  S21_PROFILE_ALLOCATION();
+  BindRows();
+}
+
+// Gives this matrix a private copy of a shared element buffer.
+void S21Matrix::Detach() {
+  if (refs_ == nullptr || refs_->load(std::memory_order_acquire) == 1) return;
+  S21_PROFILE_SCOPE("Detach", rows_, cols_, 0.0, 16.0 * rows_ * cols_);
+
+  double* shared = data_;
+  size_t shared_capacity = capacity_;
+  std::atomic<int>* shared_refs = refs_;
+  capacity_ = static_cast<size_t>(rows_) * cols_;
+  data_ = AllocateBuffer(capacity_);
+  refs_ = new std::atomic<int>(1);
+  ForEachRowBlock(rows_, 1.0 * rows_ * cols_, [&](int begin, int end) {
+    std::memcpy(data_ + static_cast<size_t>(begin) * cols_,
+                shared + static_cast<size_t>(begin) * cols_,
+                sizeof(double) * cols_ * static_cast<size_t>(end - begin));
+  });
+  BindRows();
+  // Another owner may have detached meanwhile and left us the last reference.
+  if (shared_refs->fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete shared_refs;
+    ReleaseBuffer(shared, shared_capacity);
+  }
+}
+
+// Called before every modification of the elements. References handed out
+// earlier are invalid from here on, so the buffer may be shared again.
+void S21Matrix::Touch() {
+  Detach();
+  ++version_;
+  shareable_ = true;
+}
+
+// Carries over whatever other has cached for its current contents, retagged
+// with our own version so that the version counter stays monotonic.
+void S21Matrix::AdoptCache(const S21Matrix& other) {
+  std::lock_guard<std::mutex> lock(other.cache_mutex_);
+  const DerivedCache& src = other.cache_;
+  cache_ = DerivedCache();
+  if (src.det_version == other.version_) {
+    cache_.det_version = version_;
+    cache_.det = src.det;
+  }
+  if (src.lu_version == other.version_) {
+    cache_.lu_version = version_;
+    cache_.lu = src.lu;
+  }
+  if (src.inverse_version == other.version_) {
+    cache_.inverse_version = version_;
+    cache_.inverse = src.inverse;
+  }
+}
+
+// LU decomposition with partial pivoting, PA = LU. Expects cache_mutex_ held.
+void S21Matrix::UpdateFactorization() const {
+  if (cache_.lu_version == version_) {
+    ++cache_hits_;
+    return;
+  }
+  ++cache_misses_;
+
+  // A fresh object each time: copies may still hold the previous one.
+  const int n = rows_;
+  auto factors = std::make_shared<LuFactors>();
+  std::vector<double>& lu = factors->lu;
+  std::vector<int>& perm = factors->perm;
+  lu.resize(static_cast<size_t>(n) * n);
+  perm.resize(n);
+  for (int i = 0; i < n; ++i) {
+    perm[i] = i;
+    for (int j = 0; j < n; ++j) {
+      lu[i * n + j] = matrix_[i][j];
+    }
+  }
+
+  if (n >= kTiledThreshold) {
+    factors->sign =
+        S21TiledLu(lu.data(), n, perm.data(), kTileSize, ThreadCount());
+    cache_.lu = std::move(factors);
+    cache_.lu_version = version_;
+    return;
+  }
+
+  int sign = 1;
+  for (int k = 0; k < n; ++k) {
+    int pivot = k;
+    for (int i = k + 1; i < n; ++i) {
+      if (fabs(lu[i * n + k]) > fabs(lu[pivot * n + k])) pivot = i;
+    }
+    if (pivot != k) {
+      for (int j = 0; j < n; ++j) {
+        std::swap(lu[k * n + j], lu[pivot * n + j]);
+      }
+      std::swap(perm[k], perm[pivot]);
+      sign = -sign;
+    }
+    const double diag = lu[k * n + k];
+    if (diag == 0.0) continue;
+    for (int i = k + 1; i < n; ++i) {
+      double factor = lu[i * n + k] / diag;
+      lu[i * n + k] = factor;
+      for (int j = k + 1; j < n; ++j) {
+        lu[i * n + j] -= factor * lu[k * n + j];
+      }
+    }
+  }
+  factors->sign = sign;
+  cache_.lu = std::move(factors);
+  cache_.lu_version = version_;
+}
+
+// Expects cache_mutex_ held.
+double S21Matrix::CachedDeterminant() const {
+  if (cache_.det_version == version_) {
+    ++cache_hits_;
+    return cache_.det;
+  }
+  ++cache_misses_;
+
+  double det = 0.0;
+  if (rows_ <= kS21ClosedFormSize) {
+    det = S21SmallDeterminant(matrix_, rows_);
+  } else {
+    UpdateFactorization();
+    const int n = rows_;
+    const LuFactors& factors = *cache_.lu;
+    det = factors.sign;
+    for (int i = 0; i < n; ++i) {
+      det *= factors.lu[i * n + i];
+    }
+  }
+
+  cache_.det = det;
+  cache_.det_version = version_;
+  return det;
 }
 
 int S21Matrix::GetRows() const { return rows_; }
 
 int S21Matrix::GetCols() const { return cols_; }
 
+void S21Matrix::SetMaxThreads(int threads) {
+  g_max_threads.store(threads, std::memory_order_relaxed);
+}
+
+int S21Matrix::GetMaxThreads() { return ThreadCount(); }
+
+void S21Matrix::SetCopyOnWrite(bool enabled) {
+  g_copy_on_write.store(enabled, std::memory_order_relaxed);
+}
+
+bool S21Matrix::IsCopyOnWrite() {
+  return g_copy_on_write.load(std::memory_order_relaxed);
+}
+
+void S21Matrix::SetPinThreads(bool enabled) {
+  g_pin_threads.store(enabled, std::memory_order_relaxed);
+}
+
+bool S21Matrix::IsPinThreads() {
+  return g_pin_threads.load(std::memory_order_relaxed);
+}
+
+void S21Matrix::SetTuning(const S21TuningParams& params) {
+  if (params.mul_block < 1 || params.transpose_block < 1) {
+    throw std::invalid_argument("Invalid tuning parameters");
+  }
+  g_mul_block.store(params.mul_block, std::memory_order_relaxed);
+  g_transpose_block.store(params.transpose_block, std::memory_order_relaxed);
+  g_parallel_work.store(params.parallel_work, std::memory_order_relaxed);
+  g_elementwise_work.store(params.elementwise_work,
+                           std::memory_order_relaxed);
+}
+
+S21TuningParams S21Matrix::GetTuning() {
+  S21TuningParams params;
+  params.mul_block = g_mul_block.load(std::memory_order_relaxed);
+  params.transpose_block = g_transpose_block.load(std::memory_order_relaxed);
+  params.parallel_work = g_parallel_work.load(std::memory_order_relaxed);
+  params.elementwise_work = ElementwiseWork();
+  return params;
+}
+
+bool S21Matrix::IsShared() const {
+  return refs_ != nullptr && refs_->load(std::memory_order_acquire) > 1;
+}
+
+uint64_t S21Matrix::GetVersion() const { return version_; }
+
+uint64_t S21Matrix::GetCacheHits() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return cache_hits_;
+}
+
+uint64_t S21Matrix::GetCacheMisses() const {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return cache_misses_;
+}
+
+// Writes a * b into a preallocated result that aliases neither operand.
+void S21Matrix::MulInto(const S21Matrix& a, const S21Matrix& b,
+                        S21Matrix& result) {
+  result.Touch();
+  if (a.rows_ <= kS21SmallKernelSize) {
+    if (S21SmallMulKernel kernel = S21FindSmallMul(a.cols_, b.cols_)) {
+      kernel(a.matrix_, b.matrix_, result.matrix_, a.rows_);
+      return;
+    }
+  }
+
+  // Blocked i-k-j order: rows of b are streamed contiguously and a block of
+  // b stays in cache while it is applied to every row. Each element still
+  // accumulates its products in ascending k, as the naive loop does.
+  S21Autotuner::EnsureTuned();
+  const int block = g_mul_block.load(std::memory_order_relaxed);
+  ForEachRowBlock(
+      a.rows_, 1.0 * a.rows_ * a.cols_ * b.cols_, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          std::fill(result.matrix_[i], result.matrix_[i] + b.cols_, 0.0);
+        }
+        for (int kk = 0; kk < a.cols_; kk += block) {
+          const int k_end = std::min(kk + block, a.cols_);
+          for (int jj = 0; jj < b.cols_; jj += block) {
+            const int j_end = std::min(jj + block, b.cols_);
+            for (int i = begin; i < end; ++i) {
+              double* row = result.matrix_[i];
+              for (int k = kk; k < k_end; ++k) {
+                const double aik = a.matrix_[i][k];
+                const double* b_row = b.matrix_[k];
+                for (int j = jj; j < j_end; ++j) row[j] += aik * b_row[j];
+              }
+            }
+          }
+        }
+      });
+}
+
+S21Matrix S21Matrix::Identity(int size) {
+  S21Matrix result(size, size);
+  for (int i = 0; i < size; ++i) result.matrix_[i][i] = 1.0;
+  return result;
+}
+
+// Overwrites rhs with the solution X of this * X = rhs using the cached
+// LU factorization.
+void S21Matrix::SolveInPlace(S21Matrix& rhs) const {
+  const int n = rows_;
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  UpdateFactorization();
+  const std::vector<double>& lu = cache_.lu->lu;
+  const std::vector<int>& perm = cache_.lu->perm;
+
+  rhs.Touch();
+  ForEachRowBlock(rhs.cols_, 2.0 * n * n * rhs.cols_, [&](int begin,
+                                                          int end) {
+    std::vector<double> x(n);
+    for (int col = begin; col < end; ++col) {
+      for (int i = 0; i < n; ++i) {
+        double sum = rhs.matrix_[perm[i]][col];
+        for (int k = 0; k < i; ++k) sum -= lu[i * n + k] * x[k];
+        x[i] = sum;
+      }
+      for (int i = n - 1; i >= 0; --i) {
+        double sum = x[i];
+        for (int k = i + 1; k < n; ++k) sum -= lu[i * n + k] * x[k];
+        x[i] = sum / lu[i * n + i];
+      }
+      for (int i = 0; i < n; ++i) rhs.matrix_[i][col] = x[i];
+    }
+  });
+}
+
 // Constructor
 
-S21Matrix::S21Matrix() : rows_(3), cols_(3) { AllocateMemory(rows_, cols_); }
+S21Matrix::S21Matrix() : rows_(3), cols_(3) {
+  AllocateMemory(rows_, cols_, true);
+}
 
 S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
   if (rows <= 0 || cols <= 0) {
     throw std::invalid_argument("Invalid matrix size");
   }
-  AllocateMemory(rows_, cols_);
+  AllocateMemory(rows_, cols_, true);
+}
+
+S21Matrix::S21Matrix(int rows, int cols, S21UninitializedTag)
+    : rows_(rows), cols_(cols) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument("Invalid matrix size");
+  }
+  AllocateMemory(rows_, cols_, false);
 }
 
 S21Matrix::S21Matrix(const S21Matrix& other)
     : rows_(other.rows_), cols_(other.cols_) {
-  AllocateMemory(rows_, cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
-  }
+  CopyFrom(other);
+  AdoptCache(other);
 }
 
 S21Matrix::S21Matrix(S21Matrix&& other) noexcept
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      matrix_(other.matrix_),
+      row_capacity_(other.row_capacity_),
+      data_(other.data_),
+      capacity_(other.capacity_),
+      refs_(other.refs_),
+      shareable_(other.shareable_),
+      version_(other.version_),
+      cache_(std::move(other.cache_)) {
+  ++other.version_;
+  other.shareable_ = true;
   other.rows_ = 0;
   other.cols_ = 0;
   other.matrix_ = nullptr;
+  other.row_capacity_ = 0;
+  other.data_ = nullptr;
+  other.capacity_ = 0;
+  other.refs_ = nullptr;
 }
 
 S21Matrix::~S21Matrix() {
@@ -57,6 +715,8 @@ S21Matrix::~S21Matrix() {
 // Public Methods
 
 bool S21Matrix::EqMatrix(const S21Matrix& other) const {
+  S21_PROFILE_SCOPE("EqMatrix", rows_, cols_, 1.0 * rows_ * cols_,
+                    16.0 * rows_ * cols_);
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Matrices must have the same dimensions");
   }
@@ -72,73 +732,113 @@ bool S21Matrix::EqMatrix(const S21Matrix& other) const {
 }
 
 void S21Matrix::SumMatrix(const S21Matrix& other) {
+  S21_PROFILE_SCOPE("SumMatrix", rows_, cols_, 1.0 * rows_ * cols_,
+                    24.0 * rows_ * cols_);
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Matrices must have the same dimensions");
   }
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] += other.matrix_[i][j];
-    }
-  }
+  S21Autotuner::EnsureTuned();
+  Touch();
+  ForEachRowBlock(
+      rows_, 1.0 * rows_ * cols_,
+      [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          for (int j = 0; j < cols_; ++j) {
+            matrix_[i][j] += other.matrix_[i][j];
+          }
+        }
+      },
+      ElementwiseWork());
 }
 
 void S21Matrix::SubMatrix(const S21Matrix& other) {
+  S21_PROFILE_SCOPE("SubMatrix", rows_, cols_, 1.0 * rows_ * cols_,
+                    24.0 * rows_ * cols_);
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Matrices must have the same dimensions");
   }
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] -= other.matrix_[i][j];
-    }
-  }
+  S21Autotuner::EnsureTuned();
+  Touch();
+  ForEachRowBlock(
+      rows_, 1.0 * rows_ * cols_,
+      [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          for (int j = 0; j < cols_; ++j) {
+            matrix_[i][j] -= other.matrix_[i][j];
+          }
+        }
+      },
+      ElementwiseWork());
 }
 
 void S21Matrix::MulNumber(double num) {
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] *= num;
-    }
-  }
+  S21_PROFILE_SCOPE("MulNumber", rows_, cols_, 1.0 * rows_ * cols_,
+                    16.0 * rows_ * cols_);
+  S21Autotuner::EnsureTuned();
+  Touch();
+  ForEachRowBlock(
+      rows_, 1.0 * rows_ * cols_,
+      [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          for (int j = 0; j < cols_; ++j) {
+            matrix_[i][j] *= num;
+          }
+        }
+      },
+      ElementwiseWork());
 }
 
 void S21Matrix::MulMatrix(const S21Matrix& other) {
+  S21_PROFILE_SCOPE("MulMatrix", rows_, other.cols_,
+                    2.0 * rows_ * cols_ * other.cols_,
+                    8.0 * (1.0 * rows_ * cols_ +
+                           1.0 * other.rows_ * other.cols_ +
+                           1.0 * rows_ * other.cols_));
   if (cols_ != other.rows_) {
     throw std::invalid_argument(
         "Number of columns in the first matrix must match number of rows in "
         "the second matrix");
   }
 
-  S21Matrix result(rows_, other.cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      result(i, j) = 0;
-      for (int k = 0; k < cols_; ++k) {
-        result(i, j) += matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
-  }
-  *this = result;
+  S21Matrix result(rows_, other.cols_, S21Uninitialized);
+  MulInto(*this, other, result);
+  *this = std::move(result);
 }
 
 S21Matrix S21Matrix::Transpose() const {
-  S21Matrix result(cols_, rows_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      result.matrix_[j][i] = matrix_[i][j];
-    }
-  }
+  S21_PROFILE_SCOPE("Transpose", rows_, cols_, 0.0, 16.0 * rows_ * cols_);
+  S21Autotuner::EnsureTuned();
+  S21Matrix result(cols_, rows_, S21Uninitialized);
+  const int block = g_transpose_block.load(std::memory_order_relaxed);
+  ForEachRowBlock(
+      cols_, 1.0 * rows_ * cols_,
+      [&](int begin, int end) {
+        for (int jj = begin; jj < end; jj += block) {
+          const int j_end = std::min(jj + block, end);
+          for (int ii = 0; ii < rows_; ii += block) {
+            const int i_end = std::min(ii + block, rows_);
+            for (int j = jj; j < j_end; ++j) {
+              for (int i = ii; i < i_end; ++i) {
+                result.matrix_[j][i] = matrix_[i][j];
+              }
+            }
+          }
+        }
+      },
+      ElementwiseWork());
   return result;
 }
 
 S21Matrix S21Matrix::CalcMinor(int row, int col) const {
+  S21_PROFILE_SCOPE("CalcMinor", rows_, cols_, 0.0, 16.0 * rows_ * cols_);
   if (rows_ != cols_ || rows_ < 2) {
     throw std::invalid_argument(
         "Matrix must be square and have at least 2 dimensions");
   }
 
-  S21Matrix result(rows_ - 1, cols_ - 1);
+  S21Matrix result(rows_ - 1, cols_ - 1, S21Uninitialized);
   int minor_row = 0;
 
   for (int i = 0; i < rows_; ++i) {
@@ -157,11 +857,24 @@ S21Matrix S21Matrix::CalcMinor(int row, int col) const {
 }
 
 S21Matrix S21Matrix::CalcComplements() const {
+  S21_PROFILE_SCOPE("CalcComplements", rows_, cols_,
+                    2.0 / 3.0 * rows_ * rows_ * rows_ * rows_ * cols_,
+                    8.0 * rows_ * rows_ * rows_ * cols_);
   if (rows_ != cols_) {
     throw std::invalid_argument("Matrix must be square");
   }
 
   S21Matrix result(rows_, cols_);
+  if (rows_ >= 2 && rows_ <= kS21ClosedFormSize) {
+    double cofactors[kS21ClosedFormSize * kS21ClosedFormSize];
+    S21SmallCofactors(matrix_, rows_, cofactors);
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        result.matrix_[i][j] = cofactors[i * cols_ + j];
+      }
+    }
+    return result;
+  }
 
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
@@ -174,51 +887,291 @@ S21Matrix S21Matrix::CalcComplements() const {
 }
 
 double S21Matrix::Determinant() const {
+  S21_PROFILE_SCOPE("Determinant", rows_, cols_,
+                    2.0 / 3.0 * rows_ * rows_ * cols_, 8.0 * rows_ * cols_);
   if (rows_ != cols_) {
     throw std::invalid_argument("Matrix must be square");
   }
 
-  if (rows_ == 1) {
-    return matrix_[0][0];
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  return CachedDeterminant();
+}
+
+S21Matrix S21Matrix::InverseMatrix() const {
+  S21_PROFILE_SCOPE("InverseMatrix", rows_, cols_, 2.0 * rows_ * rows_ * cols_,
+                    16.0 * rows_ * cols_);
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square");
   }
 
-  if (rows_ == 2) {
-    return matrix_[0][0] * matrix_[1][1] - matrix_[0][1] * matrix_[1][0];
+  const int n = rows_;
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (cache_.inverse_version == version_) {
+    ++cache_hits_;
+  } else {
+    ++cache_misses_;
+    // Singularity is judged by the LU pivots relative to the matrix norm.
+    // The determinant is no test: for large, well-conditioned matrices it
+    // under- or overflows long before they come close to singular.
+    UpdateFactorization();
+    double norm = 0.0;
+    for (int i = 0; i < n; ++i) {
+      double row_sum = 0.0;
+      for (int j = 0; j < n; ++j) row_sum += fabs(matrix_[i][j]);
+      norm = std::max(norm, row_sum);
+    }
+    const std::vector<double>& factors = cache_.lu->lu;
+    double smallest_pivot = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < n; ++i) {
+      smallest_pivot = std::min(smallest_pivot, fabs(factors[i * n + i]));
+    }
+    if (!(smallest_pivot >
+          n * std::numeric_limits<double>::epsilon() * norm)) {
+      throw std::invalid_argument("Matrix is singular and cannot be inverted");
+    }
+    double determinant = CachedDeterminant();
+
+    auto result = std::make_shared<std::vector<double>>(
+        static_cast<size_t>(n) * n);
+    std::vector<double>& inverse = *result;
+    if (n <= kS21ClosedFormSize && determinant != 0.0) {
+      // Adjugate divided by the determinant.
+      double cofactors[kS21ClosedFormSize * kS21ClosedFormSize];
+      S21SmallCofactors(matrix_, n, cofactors);
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+          inverse[i * n + j] = cofactors[j * n + i] / determinant;
+        }
+      }
+    } else {
+      const std::vector<double>& lu = cache_.lu->lu;
+      const std::vector<int>& perm = cache_.lu->perm;
+      // Columns of the inverse are independent solves.
+      ForEachRowBlock(n, 2.0 * n * n * n, [&](int begin, int end) {
+        std::vector<double> x(n);
+        for (int col = begin; col < end; ++col) {
+          for (int i = 0; i < n; ++i) {
+            double sum = (perm[i] == col) ? 1.0 : 0.0;
+            for (int k = 0; k < i; ++k) sum -= lu[i * n + k] * x[k];
+            x[i] = sum;
+          }
+          for (int i = n - 1; i >= 0; --i) {
+            double sum = x[i];
+            for (int k = i + 1; k < n; ++k) sum -= lu[i * n + k] * x[k];
+            x[i] = sum / lu[i * n + i];
+          }
+          for (int i = 0; i < n; ++i) inverse[i * n + col] = x[i];
+        }
+      });
+    }
+    cache_.inverse = std::move(result);
+    cache_.inverse_version = version_;
   }
 
-  double det = 0.0;
-  for (int j = 0; j < cols_; ++j) {
-    S21Matrix minor = CalcMinor(0, j);
-    double minor_det = minor.Determinant();
-    det += matrix_[0][j] * minor_det * ((j % 2 == 0) ? 1 : -1);
+  S21Matrix result(n, n, S21Uninitialized);
+  std::memcpy(result.data_, cache_.inverse->data(),
+              sizeof(double) * cache_.inverse->size());
+  return result;
+}
+
+S21Matrix S21Matrix::Power(int k) const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix must be square");
   }
+  if (k == 0) return Identity(rows_);
 
-  return det;
+  // Binary exponentiation over two pairs of ping-pong buffers, so no step
+  // allocates: one pair holds the repeated squares, the other the product.
+  // That is floor(log2 |k|) squarings plus popcount(|k|) - 1 products; the
+  // inversion for a negative power is profiled on its own.
+  S21Matrix base = k > 0 ? *this : InverseMatrix();
+  unsigned int exponent = k > 0 ? static_cast<unsigned int>(k)
+                                : 0u - static_cast<unsigned int>(k);
+  S21_PROFILE_SCOPE("Power", rows_, cols_,
+                    2.0 * rows_ * rows_ * cols_ *
+                        (std::ilogb(exponent) +
+                         static_cast<int>(std::bitset<32>(exponent).count()) -
+                         1),
+                    32.0 * rows_ * cols_);
+  S21Matrix base_next(rows_, cols_, S21Uninitialized);
+  S21Matrix acc(rows_, cols_, S21Uninitialized);
+  S21Matrix acc_next(rows_, cols_, S21Uninitialized);
+  S21Matrix *square = &base, *square_next = &base_next;
+  S21Matrix *product = &acc, *product_next = &acc_next;
+  bool empty = true;
+  for (;;) {
+    if (exponent & 1u) {
+      if (empty) {
+        for (int i = 0; i < rows_; ++i) {
+          std::copy(square->matrix_[i], square->matrix_[i] + cols_,
+                    product->matrix_[i]);
+        }
+        empty = false;
+      } else {
+        MulInto(*product, *square, *product_next);
+        std::swap(product, product_next);
+      }
+    }
+    exponent >>= 1;
+    if (exponent == 0) break;
+    MulInto(*square, *square, *square_next);
+    std::swap(square, square_next);
+  }
+  return std::move(*product);
 }
 
-S21Matrix S21Matrix::InverseMatrix() const {
+S21Matrix S21Matrix::Exp() const {
   if (rows_ != cols_) {
     throw std::invalid_argument("Matrix must be square");
   }
+  const int n = rows_;
 
-  double determinant = Determinant();
-  if (fabs(determinant) < 1e-7) {
-    throw std::invalid_argument("Matrix is singular and cannot be inverted");
+  // A NaN row sum would slip past std::max, so each row is checked.
+  double norm = 0.0;
+  for (int i = 0; i < n; ++i) {
+    double row_sum = 0.0;
+    for (int j = 0; j < n; ++j) row_sum += fabs(matrix_[i][j]);
+    if (!std::isfinite(row_sum)) {
+      throw std::invalid_argument("Matrix norm must be finite");
+    }
+    norm = std::max(norm, row_sum);
   }
 
-  S21Matrix complements = CalcComplements();
-  S21Matrix transposed = complements.Transpose();
-  S21Matrix result(rows_, cols_);
+  // Scale so that the Pade approximant of degree 6 is accurate to double
+  // precision (Golub & Van Loan, algorithm 11.3.1). A finite norm has
+  // log2 below 1024, so the cast cannot overflow.
+  const int degree = 6;
+  int squarings = 0;
+  if (norm > 0.5) {
+    squarings = std::max(0, static_cast<int>(std::ceil(std::log2(norm))) + 1);
+  }
+  // degree - 1 products for the powers, the solve and the squarings.
+  S21_PROFILE_SCOPE("Exp", rows_, cols_,
+                    2.0 * n * n * n * (degree - 1 + squarings) +
+                        8.0 / 3.0 * n * n * n,
+                    40.0 * rows_ * cols_);
+  S21Matrix scaled(*this);
+  scaled.MulNumber(std::ldexp(1.0, -squarings));
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      result.matrix_[i][j] = transposed.matrix_[i][j] / determinant;
+  S21Matrix power(scaled);
+  S21Matrix power_next(n, n, S21Uninitialized);
+  S21Matrix numerator = Identity(n);
+  S21Matrix denominator = Identity(n);
+  double c = 0.5;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      numerator.matrix_[i][j] += c * scaled.matrix_[i][j];
+      denominator.matrix_[i][j] -= c * scaled.matrix_[i][j];
+    }
+  }
+  for (int q = 2; q <= degree; ++q) {
+    c *= static_cast<double>(degree - q + 1) / (q * (2 * degree - q + 1));
+    MulInto(scaled, power, power_next);
+    std::swap(power, power_next);
+    double sign = (q % 2 == 0) ? 1.0 : -1.0;
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        numerator.matrix_[i][j] += c * power.matrix_[i][j];
+        denominator.matrix_[i][j] += sign * c * power.matrix_[i][j];
+      }
     }
   }
 
-  return result;
+  denominator.SolveInPlace(numerator);
+  S21Matrix* result = &numerator;
+  S21Matrix* result_next = &power_next;
+  for (int s = 0; s < squarings; ++s) {
+    MulInto(*result, *result, *result_next);
+    std::swap(result, result_next);
+  }
+  return std::move(*result);
+}
+
+// Resize
+
+// A moved-from matrix has neither rows nor columns, and setting one of them
+// alone would leave a shape the constructors reject.
+void S21Matrix::SetRows(int rows) {
+  if (rows <= 0 || cols_ <= 0) {
+    throw std::invalid_argument("Invalid matrix size");
+  }
+  Touch();
+  const int old_rows = rows_;
+  if (rows > rows_) {
+    EnsureCapacity(rows, cols_, false);
+    std::fill_n(data_ + static_cast<size_t>(rows_) * cols_,
+                static_cast<size_t>(cols_) * (rows - rows_), 0.0);
+  }
+  rows_ = rows;
+  if (rows > old_rows) BindRows(old_rows);
+}
+
+void S21Matrix::SetCols(int cols) {
+  if (cols <= 0 || rows_ <= 0) {
+    throw std::invalid_argument("Invalid matrix size");
+  }
+  Touch();
+  const size_t old_cols = cols_;
+  const size_t new_cols = cols;
+  if (new_cols > old_cols) {
+    EnsureCapacity(rows_, cols, false);
+    // Rows move towards the end, so the last row goes first.
+    for (int i = rows_ - 1; i >= 0; --i) {
+      std::memmove(data_ + i * new_cols, data_ + i * old_cols,
+                   sizeof(double) * old_cols);
+      std::memset(data_ + i * new_cols + old_cols, 0,
+                  sizeof(double) * (new_cols - old_cols));
+    }
+  } else {
+    for (int i = 1; i < rows_; ++i) {
+      std::memmove(data_ + i * new_cols, data_ + i * old_cols,
+                   sizeof(double) * new_cols);
+    }
+  }
+  cols_ = cols;
+  BindRows();
+}
+
+void S21Matrix::Reserve(int rows, int cols) {
+  if (rows <= 0 || cols <= 0) {
+    throw std::invalid_argument("Invalid matrix size");
+  }
+  Detach();
+  EnsureCapacity(rows, cols, true);
+}
+
+void S21Matrix::Reshape(int rows, int cols) {
+  if (rows <= 0 || cols <= 0 ||
+      static_cast<size_t>(rows) * cols != static_cast<size_t>(rows_) * cols_) {
+    throw std::invalid_argument("Reshape must keep the number of elements");
+  }
+  Touch();
+  EnsureCapacity(rows, cols, false);
+  rows_ = rows;
+  cols_ = cols;
+  BindRows();
+}
+
+void S21Matrix::AppendRow(const std::vector<double>& values) {
+  if (values.empty()) {
+    throw std::invalid_argument("Invalid matrix size");
+  }
+  // The first row appended to a moved-from matrix sets its width.
+  const int cols = cols_ > 0 ? cols_ : static_cast<int>(values.size());
+  if (values.size() != static_cast<size_t>(cols)) {
+    throw std::invalid_argument(
+        "Row length must match the number of columns");
+  }
+  Touch();
+  EnsureCapacity(rows_ + 1, cols, false);
+  cols_ = cols;
+  double* row = data_ + static_cast<size_t>(rows_) * cols_;
+  std::copy(values.begin(), values.end(), row);
+  matrix_[rows_++] = row;
 }
 
+size_t S21Matrix::GetCapacity() const { return capacity_; }
+
 // Operators
 
 S21Matrix S21Matrix::operator+(const S21Matrix& other) const {
@@ -250,18 +1203,51 @@ bool S21Matrix::operator==(const S21Matrix& other) const {
 }
 
 S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
+  if (this != &other) {
+    if (matrix_ != nullptr) {
+      FreeMemory();
+    }
+    CopyFrom(other);
+    ++version_;
+    AdoptCache(other);
+  }
+  return *this;
+}
+
+S21Matrix& S21Matrix::operator=(S21Matrix&& other) noexcept {
   if (this != &other) {
     if (matrix_ != nullptr) {
       FreeMemory();
     }
     rows_ = other.rows_;
     cols_ = other.cols_;
-    AllocateMemory(rows_, cols_);
-    for (int i = 0; i < rows_; ++i) {
-      for (int j = 0; j < cols_; ++j) {
-        matrix_[i][j] = other.matrix_[i][j];
-      }
+    matrix_ = other.matrix_;
+    row_capacity_ = other.row_capacity_;
+    data_ = other.data_;
+    capacity_ = other.capacity_;
+    refs_ = other.refs_;
+    shareable_ = other.shareable_;
+
+    // Cached values stay valid for the moved contents; retag them with a
+    // version above both counters.
+    uint64_t source_version = other.version_;
+    version_ = std::max(version_, source_version) + 1;
+    cache_ = std::move(other.cache_);
+    if (cache_.det_version == source_version) cache_.det_version = version_;
+    if (cache_.lu_version == source_version) cache_.lu_version = version_;
+    if (cache_.inverse_version == source_version) {
+      cache_.inverse_version = version_;
     }
+
+    ++other.version_;
+    other.rows_ = 0;
+    other.cols_ = 0;
+    other.matrix_ = nullptr;
+    other.row_capacity_ = 0;
+    other.data_ = nullptr;
+    other.capacity_ = 0;
+    other.refs_ = nullptr;
+    other.shareable_ = true;
   }
   return *this;
 }
@@ -290,6 +1276,9 @@ double& S21Matrix::operator()(int row, int col) {
   if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
     throw std::out_of_range("Index out of range");
   }
+  Touch();
+  // The caller may keep writing through the reference after a copy.
+  shareable_ = false;
   return matrix_[row][col];
 }
 
@@ -298,4 +1287,20 @@ const double& S21Matrix::operator()(int row, int col) const {
     throw std::out_of_range("Index out of range");
   }
   return matrix_[row][col];
+}
+
+double* S21Matrix::RowData(int row) {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range("Index out of range");
+  }
+  Touch();
+  shareable_ = false;
+  return matrix_[row];
+}
+
+const double* S21Matrix::RowData(int row) const {
+  if (row < 0 || row >= rows_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return matrix_[row];
 }
\ No newline at end of file
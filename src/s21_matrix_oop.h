@@ -1,25 +1,111 @@
 #ifndef S21_MATRIX_OOP_H
 #define S21_MATRIX_OOP_H
 
+#include <atomic>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <exception>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 #define S21_EPS 1e-7
 
+// Тег конструктора, оставляющего элементы матрицы неинициализированными
+struct S21UninitializedTag {
+  explicit S21UninitializedTag() = default;
+};
+inline constexpr S21UninitializedTag S21Uninitialized{};
+
+// Параметры ядер, зависящие от процессора. Подбираются S21Autotuner
+struct S21TuningParams {
+  int mul_block = 64;  // Блок по внутреннему измерению и столбцам в MulMatrix
+  int transpose_block = 32;  // Сторона блока в Transpose
+  // Наименьший объем работы, с которого умножение и разложения
+  // выполняются в нескольких потоках
+  double parallel_work = 1 << 18;
+  // То же для поэлементных операций и транспонирования
+  double elementwise_work = 1 << 18;
+};
+
 class S21Matrix {
  private:
+  // Разложение PA = LU
+  struct LuFactors {
+    std::vector<double> lu;  // L и U в одном буфере rows_ x rows_
+    std::vector<int> perm;
+    int sign = 1;
+  };
+  // Производные величины, вычисленные для конкретной версии матрицы.
+  // Тег 0 означает, что значение не вычислено. Разложение и обратная
+  // матрица не изменяются после вычисления и разделяются между копиями.
+  struct DerivedCache {
+    uint64_t det_version = 0;
+    double det = 0.0;
+    uint64_t lu_version = 0;
+    std::shared_ptr<const LuFactors> lu;
+    uint64_t inverse_version = 0;
+    std::shared_ptr<const std::vector<double>> inverse;
+  };
+
   int rows_, cols_;
-  double **matrix_;
+  double **matrix_;  // Указатели на строки внутри data_
+  int row_capacity_ = 0;  // Длина массива matrix_
+  double *data_ = nullptr;
+  size_t capacity_ = 0;  // Число элементов, выделенных под data_
+  // Счетчик владельцев data_; больше 1 только в режиме копирования при записи
+  std::atomic<int> *refs_ = nullptr;
+  // false, пока снаружи может остаться ссылка на элемент, выданная
+  // operator() или RowData; такой буфер копии не разделяют
+  bool shareable_ = true;
+  uint64_t version_ = 1;
+  mutable std::mutex cache_mutex_;
+  mutable DerivedCache cache_;
+  mutable uint64_t cache_hits_ = 0;
+  mutable uint64_t cache_misses_ = 0;
 
-  void AllocateMemory(int rows, int cols);
+  void AllocateMemory(int rows, int cols, bool zero_fill);
   void FreeMemory();
+  void BindRows(int first = 0);  // Строки с first по rows_ - 1
+  void EnsureCapacity(int rows, int cols, bool exact);
+  void CopyFrom(const S21Matrix &other);
+  void Detach();
+  void Touch();
+  void AdoptCache(const S21Matrix &other);
+  void UpdateFactorization() const;
+  double CachedDeterminant() const;
+  void SolveInPlace(S21Matrix &rhs) const;
+  static void MulInto(const S21Matrix &a, const S21Matrix &b,
+                      S21Matrix &result);
+  static S21Matrix Identity(int size);
 
  public:
   int GetRows() const;
   int GetCols() const;
+  // Версия увеличивается при каждом изменяющем вызове
+  uint64_t GetVersion() const;
+  uint64_t GetCacheHits() const;
+  uint64_t GetCacheMisses() const;
+  // Число потоков для многопоточных ядер, 0 - по числу ядер процессора
+  static void SetMaxThreads(int threads);
+  static int GetMaxThreads();
+  // Режим копирования при записи: копии разделяют буфер элементов до
+  // первого изменения одной из них
+  static void SetCopyOnWrite(bool enabled);
+  static bool IsCopyOnWrite();
+  // Привязка рабочих потоков к отдельным ядрам. По умолчанию выключена,
+  // чтобы не мешать планировщику и другим процессам
+  static void SetPinThreads(bool enabled);
+  static bool IsPinThreads();
+  static void SetTuning(const S21TuningParams &params);
+  static S21TuningParams GetTuning();
+  bool IsShared() const;
   // Конструкторы и деструктор
   S21Matrix();  // Конструктор по умолчанию
   S21Matrix(int rows, int cols);  // Конструктор с параметрами
+  S21Matrix(int rows, int cols, S21UninitializedTag);  // Без обнуления
   S21Matrix(const S21Matrix &other);  // Конструктор копирования
   S21Matrix(S21Matrix &&other) noexcept;  // Конструктор перемещения
   ~S21Matrix();                           // Деструктор
@@ -35,6 +121,30 @@ class S21Matrix {
   S21Matrix CalcComplements() const;
   double Determinant() const;
   S21Matrix InverseMatrix() const;
+  // Степень за O(log |k|) умножений, отрицательная - через обратную матрицу
+  S21Matrix Power(int k) const;
+  // Матричная экспонента: масштабирование и возведение в квадрат с
+  // аппроксимацией Паде
+  S21Matrix Exp() const;
+
+  // Изменение размеров. Емкость растет геометрически, как у std::vector,
+  // уменьшение размеров никогда не перевыделяет память. Новые элементы
+  // заполняются нулями. У перемещенной матрицы нельзя задать только одно
+  // измерение, первая добавленная строка задает число столбцов.
+  void SetRows(int rows);
+  void SetCols(int cols);
+  void Reserve(int rows, int cols);
+  void Reshape(int rows, int cols);  // Сохраняет порядок элементов по строкам
+  void AppendRow(const std::vector<double> &values);
+  size_t GetCapacity() const;  // В элементах
+
+  // Текстовый формат: строка файла - строка матрицы. В CSV значения
+  // разделяются delimiter, в текстовом варианте - пробелами и табуляциями.
+  // Запись сохраняет каждое значение без потери точности.
+  static S21Matrix FromCsv(const std::string &path, char delimiter = ',');
+  static S21Matrix FromText(const std::string &path);
+  void ToCsv(const std::string &path, char delimiter = ',') const;
+  void ToText(const std::string &path) const;
 
   // Операторы
   S21Matrix operator+(const S21Matrix &other) const;
@@ -43,12 +153,20 @@ class S21Matrix {
   S21Matrix operator*(const S21Matrix &other) const;
   bool operator==(const S21Matrix &other) const;
   S21Matrix &operator=(const S21Matrix &other);
+  S21Matrix &operator=(S21Matrix &&other) noexcept;
   S21Matrix &operator+=(const S21Matrix &other);
   S21Matrix &operator-=(const S21Matrix &other);
   S21Matrix &operator*=(double num);
   S21Matrix &operator*=(const S21Matrix &other);
+  // Считается изменением матрицы. В режиме копирования при записи
+  // ссылка действительна до следующего изменяющего вызова
   double &operator()(int i, int j);
   const double &operator()(int i, int j) const;
+
+  // Прямой доступ к строке; неконстантный вариант считается изменением
+  // и действует так же, как неконстантный operator()
+  double *RowData(int row);
+  const double *RowData(int row) const;
 };
 
 #endif  // S21_MATRIX_OOP_H
\ No newline at end of file
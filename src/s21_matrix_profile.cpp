@@ -0,0 +1,211 @@
+#include "s21_matrix_profile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace {
+
+struct ThreadBuffer {
+  std::mutex mutex;
+  std::vector<S21ProfileRecord> records;
+  uint32_t thread_id = 0;
+};
+
+// Buffers are owned by the registry so that records of finished threads
+// remain available until the next Reset().
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+  uint32_t next_thread_id = 1;
+};
+
+std::atomic<bool> g_enabled{false};
+thread_local uint64_t t_allocations = 0;
+
+Registry &GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+ThreadBuffer &LocalBuffer() {
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+  if (!buffer) {
+    buffer = std::make_shared<ThreadBuffer>();
+    Registry &registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    buffer->thread_id = registry.next_thread_id++;
+    registry.buffers.push_back(buffer);
+  }
+  return *buffer;
+}
+
+int64_t NowNs() {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(
+             steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void AppendJsonString(std::ostringstream &out, const char *text) {
+  out << '"';
+  for (const char *c = text; *c; ++c) {
+    if (*c == '"' || *c == '\\') out << '\\';
+    out << *c;
+  }
+  out << '"';
+}
+
+}  // namespace
+
+// S21Profiler
+
+void S21Profiler::Enable(bool enabled) {
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool S21Profiler::IsEnabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+void S21Profiler::Reset() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto &buffer : registry.buffers) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    buffer->records.clear();
+  }
+}
+
+std::vector<S21ProfileRecord> S21Profiler::Collect() {
+  std::vector<S21ProfileRecord> result;
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (auto &buffer : registry.buffers) {
+    std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+    result.insert(result.end(), buffer->records.begin(),
+                  buffer->records.end());
+  }
+  std::sort(result.begin(), result.end(),
+            [](const S21ProfileRecord &a, const S21ProfileRecord &b) {
+              return a.start_ns < b.start_ns;
+            });
+  return result;
+}
+
+std::vector<S21ProfileStats> S21Profiler::Aggregate() {
+  std::map<std::string, S21ProfileStats> by_name;
+  for (const S21ProfileRecord &record : Collect()) {
+    S21ProfileStats &stats = by_name[record.name];
+    stats.name = record.name;
+    stats.calls += 1;
+    stats.total_ns += record.duration_ns;
+    stats.flops += record.flops;
+    stats.bytes += record.bytes;
+    stats.allocations += record.allocations;
+  }
+
+  std::vector<S21ProfileStats> result;
+  for (auto &entry : by_name) result.push_back(entry.second);
+  std::sort(result.begin(), result.end(),
+            [](const S21ProfileStats &a, const S21ProfileStats &b) {
+              return a.total_ns > b.total_ns;
+            });
+  return result;
+}
+
+std::string S21Profiler::ChromeTrace() {
+  std::vector<S21ProfileRecord> records = Collect();
+  int64_t origin = records.empty() ? 0 : records.front().start_ns;
+
+  std::ostringstream out;
+  out << "{\"traceEvents\":[";
+  for (size_t i = 0; i < records.size(); ++i) {
+    const S21ProfileRecord &record = records[i];
+    if (i != 0) out << ',';
+    out << "\n{\"name\":";
+    AppendJsonString(out, record.name);
+    // Timestamps are in microseconds with nanosecond resolution; the
+    // default six significant digits would lose it after one second.
+    out << ",\"cat\":\"s21_matrix\",\"ph\":\"X\",\"pid\":1"
+        << ",\"tid\":" << record.thread_id << std::fixed
+        << std::setprecision(3)
+        << ",\"ts\":" << (record.start_ns - origin) / 1000.0
+        << ",\"dur\":" << record.duration_ns / 1000.0 << std::defaultfloat
+        << std::setprecision(17) << ",\"args\":{\"rows\":" << record.rows
+        << ",\"cols\":" << record.cols << ",\"flops\":" << record.flops
+        << ",\"bytes\":" << record.bytes
+        << ",\"allocations\":" << record.allocations << "}}";
+  }
+  out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+  return out.str();
+}
+
+bool S21Profiler::WriteChromeTrace(const std::string &path) {
+  std::ofstream file(path);
+  if (!file) return false;
+  file << ChromeTrace();
+  return static_cast<bool>(file);
+}
+
+std::string S21Profiler::Summary() {
+  std::ostringstream out;
+  char line[160];
+  std::snprintf(line, sizeof(line), "%-16s %10s %12s %12s %10s %10s %12s\n",
+                "method", "calls", "total_ms", "avg_us", "GFLOP/s", "GB/s",
+                "allocations");
+  out << line;
+  for (const S21ProfileStats &stats : Aggregate()) {
+    double seconds = stats.total_ns * 1e-9;
+    double gflops = seconds > 0 ? stats.flops / seconds * 1e-9 : 0.0;
+    double gbytes = seconds > 0 ? stats.bytes / seconds * 1e-9 : 0.0;
+    std::snprintf(line, sizeof(line),
+                  "%-16s %10llu %12.3f %12.3f %10.3f %10.3f %12llu\n",
+                  stats.name.c_str(),
+                  static_cast<unsigned long long>(stats.calls),
+                  stats.total_ns * 1e-6,
+                  stats.total_ns * 1e-3 / static_cast<double>(stats.calls),
+                  gflops, gbytes,
+                  static_cast<unsigned long long>(stats.allocations));
+    out << line;
+  }
+  return out.str();
+}
+
+void S21Profiler::CountAllocation() { ++t_allocations; }
+
+// S21ProfileScope
+
+S21ProfileScope::S21ProfileScope(const char *name, int rows, int cols,
+                                 double flops, double bytes)
+    : name_(name),
+      rows_(rows),
+      cols_(cols),
+      flops_(flops),
+      bytes_(bytes),
+      start_ns_(0),
+      start_allocations_(0),
+      active_(S21Profiler::IsEnabled()) {
+  if (active_) {
+    start_allocations_ = t_allocations;
+    start_ns_ = NowNs();
+  }
+}
+
+S21ProfileScope::~S21ProfileScope() {
+  if (!active_) return;
+  int64_t end_ns = NowNs();
+  ThreadBuffer &buffer = LocalBuffer();
+  std::lock_guard<std::mutex> lock(buffer.mutex);
+  buffer.records.push_back({name_, rows_, cols_, start_ns_, end_ns - start_ns_,
+                            flops_, bytes_,
+                            t_allocations - start_allocations_,
+                            buffer.thread_id});
+}
@@ -0,0 +1,75 @@
+#ifndef S21_MATRIX_PROFILE_H
+#define S21_MATRIX_PROFILE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Одна запись о вызове метода S21Matrix
+struct S21ProfileRecord {
+  const char *name;
+  int rows, cols;
+  int64_t start_ns;
+  int64_t duration_ns;
+  double flops;  // Оценка числа операций с плавающей точкой
+  double bytes;  // Оценка объема прочитанной и записанной памяти
+  uint64_t allocations;
+  uint32_t thread_id;
+};
+
+// Агрегированная статистика по одному методу
+struct S21ProfileStats {
+  std::string name;
+  uint64_t calls;
+  int64_t total_ns;
+  double flops;
+  double bytes;
+  uint64_t allocations;
+};
+
+// Сбор статистики по вызовам. Записи копятся в буферах потоков и
+// собираются только по запросу. Хуки в библиотеке компилируются лишь
+// при определенном S21_MATRIX_PROFILE, запись включается Enable(true).
+class S21Profiler {
+ public:
+  static void Enable(bool enabled);
+  static bool IsEnabled();
+  static void Reset();
+
+  static std::vector<S21ProfileRecord> Collect();
+  static std::vector<S21ProfileStats> Aggregate();
+  static std::string ChromeTrace();
+  static bool WriteChromeTrace(const std::string &path);
+  static std::string Summary();
+
+  static void CountAllocation();
+};
+
+// RAII-замер одного вызова
+class S21ProfileScope {
+ public:
+  S21ProfileScope(const char *name, int rows, int cols, double flops,
+                  double bytes);
+  ~S21ProfileScope();
+  S21ProfileScope(const S21ProfileScope &) = delete;
+  S21ProfileScope &operator=(const S21ProfileScope &) = delete;
+
+ private:
+  const char *name_;
+  int rows_, cols_;
+  double flops_, bytes_;
+  int64_t start_ns_;
+  uint64_t start_allocations_;
+  bool active_;
+};
+
+#ifdef S21_MATRIX_PROFILE
+#define S21_PROFILE_SCOPE(name, rows, cols, flops, bytes) \
+  S21ProfileScope s21_profile_scope_(name, rows, cols, flops, bytes)
+#define S21_PROFILE_ALLOCATION() S21Profiler::CountAllocation()
+#else
+#define S21_PROFILE_SCOPE(name, rows, cols, flops, bytes) ((void)0)
+#define S21_PROFILE_ALLOCATION() ((void)0)
+#endif
+
+#endif  // S21_MATRIX_PROFILE_H
@@ -0,0 +1,291 @@
+// Hardware counter profiling harness for S21Matrix kernels.
+// Runs each kernel over a size sweep and prints one CSV row per
+// (kernel, size) so that reports of different library versions can be
+// diffed or joined on those two columns. Kernels that run on several
+// threads are timed once more on one thread to report parallel efficiency.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+enum Counter {
+  kCycles,
+  kInstructions,
+  kL1dMisses,
+  kLlcMisses,
+  kDtlbMisses,
+  kCounterCount
+};
+
+const char *const kCounterNames[kCounterCount] = {
+    "cycles", "instructions", "l1d_misses", "llc_misses", "dtlb_misses"};
+
+// A set of independently opened counters for the calling thread and every
+// thread it creates afterwards. The library's worker pools start lazily on
+// the first threaded call, so counters opened before any matrix call also
+// cover the row-block and task-scheduler workers; reading a counter sums
+// over all of those threads. Counters that the host or its
+// perf_event_paranoid setting does not allow are left closed and reported
+// as NA.
+class PerfCounters {
+ public:
+  PerfCounters() {
+    for (int i = 0; i < kCounterCount; ++i) fds_[i] = -1;
+#ifdef __linux__
+    const uint64_t cache_read_miss =
+        (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    fds_[kCycles] = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    fds_[kInstructions] =
+        Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    fds_[kL1dMisses] =
+        Open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | cache_read_miss);
+    fds_[kLlcMisses] = Open(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    fds_[kDtlbMisses] =
+        Open(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | cache_read_miss);
+#endif
+  }
+
+  ~PerfCounters() {
+#ifdef __linux__
+    for (int fd : fds_) {
+      if (fd >= 0) close(fd);
+    }
+#endif
+  }
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  bool Available(int counter) const { return fds_[counter] >= 0; }
+
+  void Start() {
+#ifdef __linux__
+    for (int fd : fds_) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  // Adds the counts since Start() to totals.
+  void Stop(uint64_t *totals) {
+#ifdef __linux__
+    for (int i = 0; i < kCounterCount; ++i) {
+      if (fds_[i] < 0) continue;
+      ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+      uint64_t value = 0;
+      if (read(fds_[i], &value, sizeof(value)) == sizeof(value)) {
+        totals[i] += value;
+      }
+    }
+#else
+    (void)totals;
+#endif
+  }
+
+ private:
+#ifdef __linux__
+  static int Open(uint32_t type, uint64_t config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(
+        syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+#endif
+
+  int fds_[kCounterCount];
+};
+
+double NowSeconds() {
+  using namespace std::chrono;
+  return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+// Runs body(begin, end) over [0, n) split between threads.
+void SplitAcross(int threads, size_t n,
+                 const std::function<void(size_t, size_t)> &body) {
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back(body, n * t / threads, n * (t + 1) / threads);
+  }
+  for (std::thread &worker : workers) worker.join();
+}
+
+// In-place STREAM-style kernel a += s * b on as many threads as the
+// library uses, best of several passes, in GB/s. It reads a and b and
+// writes a back, the access pattern of SumMatrix and MulNumber, so no
+// read-for-ownership goes uncounted as it would for the triad's
+// write-only destination. Each thread first touches the slice it later
+// streams, as the library's own kernels do.
+double MeasurePeakBandwidth(int threads) {
+  const size_t n = size_t(1) << 23;
+  const int passes = 5;
+  std::unique_ptr<double[]> a(new double[n]), b(new double[n]);
+  SplitAcross(threads, n, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      a[i] = 0.0;
+      b[i] = 1.0;
+    }
+  });
+  double best = 0.0;
+  for (int pass = 0; pass < passes; ++pass) {
+    double start = NowSeconds();
+    SplitAcross(threads, n, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; ++i) a[i] += 3.0 * b[i];
+    });
+    double elapsed = NowSeconds() - start;
+    if (elapsed > 0) best = std::max(best, 3.0 * sizeof(double) * n / elapsed);
+  }
+  // Keeps the kernel from being optimized away.
+  if (a[n / 2] != 3.0 * passes) std::fprintf(stderr, "stream check failed\n");
+  return best * 1e-9;
+}
+
+void Fill(S21Matrix &matrix, int seed) {
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    for (int j = 0; j < matrix.GetCols(); ++j) {
+      matrix(i, j) = ((i * 31 + j * 17 + seed) % 97) / 97.0 + (i == j ? 4 : 0);
+    }
+  }
+}
+
+struct Kernel {
+  const char *name;
+  int max_size;
+  // Estimated bytes read and written by one call on an n x n operand.
+  double (*bytes)(double n);
+  // Runs one call on a freshly filled a and a fixed b.
+  std::function<void(S21Matrix &, const S21Matrix &)> run;
+  // Also timed on a single thread to report parallel efficiency.
+  bool scaling;
+};
+
+std::vector<Kernel> Kernels() {
+  return {
+      {"MulMatrix", 512, [](double n) { return 8.0 * 3 * n * n; },
+       [](S21Matrix &a, const S21Matrix &b) { a.MulMatrix(b); }, true},
+      {"Transpose", 2048, [](double n) { return 8.0 * 2 * n * n; },
+       [](S21Matrix &a, const S21Matrix &) { a.Transpose(); }, false},
+      {"SumMatrix", 2048, [](double n) { return 8.0 * 3 * n * n; },
+       [](S21Matrix &a, const S21Matrix &b) { a.SumMatrix(b); }, false},
+      {"MulNumber", 2048, [](double n) { return 8.0 * 2 * n * n; },
+       [](S21Matrix &a, const S21Matrix &) { a.MulNumber(1.0); }, false},
+      {"Determinant", 1024, [](double n) { return 8.0 * n * n; },
+       [](S21Matrix &a, const S21Matrix &) { a.Determinant(); }, true},
+      {"InverseMatrix", 512, [](double n) { return 8.0 * 2 * n * n; },
+       [](S21Matrix &a, const S21Matrix &) { a.InverseMatrix(); }, true},
+  };
+}
+
+// Average seconds per call; counts are added to totals when given.
+double Measure(const Kernel &kernel, int n, int repeats,
+               PerfCounters &counters, uint64_t *totals) {
+  S21Matrix b(n, n);
+  Fill(b, 2);
+  double seconds = 0.0;
+  for (int r = 0; r < repeats; ++r) {
+    // A fresh operand each time, so cached derived values and results
+    // of the previous repeat never shortcut the measured call.
+    S21Matrix a(n, n);
+    Fill(a, r);
+    if (totals) counters.Start();
+    double start = NowSeconds();
+    kernel.run(a, b);
+    seconds += NowSeconds() - start;
+    if (totals) counters.Stop(totals);
+  }
+  return seconds / repeats;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const char *label = argc > 1 ? argv[1] : "current";
+  const int repeats = 3;
+  // Opened before anything starts the library's worker threads.
+  PerfCounters counters;
+  const int threads = S21Matrix::GetMaxThreads();
+  const double peak = MeasurePeakBandwidth(threads);
+
+  for (int i = 0; i < kCounterCount; ++i) {
+    if (!counters.Available(i)) {
+      std::fprintf(stderr, "s21_perf: counter %s unavailable\n",
+                   kCounterNames[i]);
+    }
+  }
+
+  std::printf(
+      "version,kernel,n,seconds,cycles,instructions,ipc,l1d_misses,"
+      "llc_misses,dtlb_misses,bytes,bandwidth_gbs,peak_gbs,peak_fraction,"
+      "threads,parallel_efficiency\n");
+  for (const Kernel &kernel : Kernels()) {
+    for (int n = 64; n <= kernel.max_size; n *= 2) {
+      uint64_t totals[kCounterCount] = {};
+      double seconds = Measure(kernel, n, repeats, counters, totals);
+      double serial = 0.0;
+      if (kernel.scaling) {
+        S21Matrix::SetMaxThreads(1);
+        serial = Measure(kernel, n, repeats, counters, nullptr);
+        S21Matrix::SetMaxThreads(0);
+      }
+      double bytes = kernel.bytes(n);
+      double bandwidth = seconds > 0 ? bytes / seconds * 1e-9 : 0.0;
+
+      std::printf("%s,%s,%d,%.6e", label, kernel.name, n, seconds);
+      for (int i = 0; i < kCounterCount; ++i) {
+        if (counters.Available(i)) {
+          std::printf(",%.0f", static_cast<double>(totals[i]) / repeats);
+        } else {
+          std::printf(",NA");
+        }
+        if (i == kInstructions) {
+          if (counters.Available(kCycles) &&
+              counters.Available(kInstructions) && totals[kCycles] > 0) {
+            std::printf(",%.3f", static_cast<double>(totals[kInstructions]) /
+                                     static_cast<double>(totals[kCycles]));
+          } else {
+            std::printf(",NA");
+          }
+        }
+      }
+      std::printf(",%.0f,%.3f,%.3f,%.4f,%d", bytes, bandwidth, peak,
+                  peak > 0 ? bandwidth / peak : 0.0, threads);
+      // T(1) / (p * T(p)); 1.0 is perfect scaling.
+      if (kernel.scaling && seconds > 0) {
+        std::printf(",%.3f\n", serial / (threads * seconds));
+      } else {
+        std::printf(",NA\n");
+      }
+      std::fflush(stdout);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,133 @@
+#include "s21_small_kernels.h"
+
+#include <array>
+#include <utility>
+
+namespace {
+
+// The trip counts are template parameters, so the compiler unrolls and
+// vectorizes each instantiation for its exact shape. Sums are accumulated
+// in the same order as the generic kernel, so results are bit-identical.
+template <int K, int N>
+void MulKernel(const double *const *a, const double *const *b,
+               double *const *c, int rows) {
+  for (int i = 0; i < rows; ++i) {
+    double acc[N] = {};
+    for (int k = 0; k < K; ++k) {
+      const double aik = a[i][k];
+      for (int j = 0; j < N; ++j) acc[j] += aik * b[k][j];
+    }
+    for (int j = 0; j < N; ++j) c[i][j] = acc[j];
+  }
+}
+
+template <int... I>
+constexpr std::array<S21SmallMulKernel, sizeof...(I)> MakeMulTable(
+    std::integer_sequence<int, I...>) {
+  return {{&MulKernel<I / kS21SmallKernelSize + 1,
+                      I % kS21SmallKernelSize + 1>...}};
+}
+
+// Indexed by (k - 1) * kS21SmallKernelSize + (n - 1).
+constexpr auto kMulTable = MakeMulTable(
+    std::make_integer_sequence<int, kS21SmallKernelSize *
+                                        kS21SmallKernelSize>{});
+
+// Copies a without row and col into minor. Rows is anything indexable as
+// rows[i][j].
+template <int N, typename Rows>
+void Minor(const Rows &a, int row, int col, double (&minor)[N - 1][N - 1]) {
+  for (int i = 0, mi = 0; i < N; ++i) {
+    if (i == row) continue;
+    for (int j = 0, mj = 0; j < N; ++j) {
+      if (j == col) continue;
+      minor[mi][mj++] = a[i][j];
+    }
+    ++mi;
+  }
+}
+
+template <int N, typename Rows>
+double Det(const Rows &a) {
+  if constexpr (N == 1) {
+    return a[0][0];
+  } else if constexpr (N == 2) {
+    return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+  } else if constexpr (N == 3) {
+    double det = 0.0;
+    det += a[0][0] * (a[1][1] * a[2][2] - a[1][2] * a[2][1]);
+    det -= a[0][1] * (a[1][0] * a[2][2] - a[1][2] * a[2][0]);
+    det += a[0][2] * (a[1][0] * a[2][1] - a[1][1] * a[2][0]);
+    return det;
+  } else {
+    // Expansion along the first row.
+    double det = 0.0;
+    for (int j = 0; j < N; ++j) {
+      double minor[N - 1][N - 1];
+      Minor<N>(a, 0, j, minor);
+      double term = a[0][j] * Det<N - 1>(minor);
+      det += (j % 2 == 0) ? term : -term;
+    }
+    return det;
+  }
+}
+
+template <int N>
+void Cofactors(const double *const *a, double *cofactors) {
+  if constexpr (N == 1) {
+    (void)a;
+    cofactors[0] = 1.0;
+  } else {
+    for (int i = 0; i < N; ++i) {
+      for (int j = 0; j < N; ++j) {
+        double minor[N - 1][N - 1];
+        Minor<N>(a, i, j, minor);
+        double value = Det<N - 1>(minor);
+        cofactors[i * N + j] = ((i + j) % 2 == 0) ? value : -value;
+      }
+    }
+  }
+}
+
+}  // namespace
+
+S21SmallMulKernel S21FindSmallMul(int k, int n) {
+  if (k < 1 || n < 1 || k > kS21SmallKernelSize || n > kS21SmallKernelSize) {
+    return nullptr;
+  }
+  return kMulTable[(k - 1) * kS21SmallKernelSize + (n - 1)];
+}
+
+double S21SmallDeterminant(const double *const *a, int n) {
+  switch (n) {
+    case 1:
+      return Det<1>(a);
+    case 2:
+      return Det<2>(a);
+    case 3:
+      return Det<3>(a);
+    case 4:
+      return Det<4>(a);
+    default:
+      return 0.0;
+  }
+}
+
+void S21SmallCofactors(const double *const *a, int n, double *cofactors) {
+  switch (n) {
+    case 1:
+      Cofactors<1>(a, cofactors);
+      break;
+    case 2:
+      Cofactors<2>(a, cofactors);
+      break;
+    case 3:
+      Cofactors<3>(a, cofactors);
+      break;
+    case 4:
+      Cofactors<4>(a, cofactors);
+      break;
+    default:
+      break;
+  }
+}
@@ -0,0 +1,31 @@
+#ifndef S21_SMALL_KERNELS_H
+#define S21_SMALL_KERNELS_H
+
+// Ядра для малых матриц, размеры которых известны только во время
+// выполнения. Для каждого сочетания размеров заранее собран вариант с
+// постоянными границами циклов, нужный выбирается по размерам операндов.
+// Матрицы передаются массивами указателей на строки.
+
+// Наибольший размер, для которого есть специализированное умножение
+constexpr int kS21SmallKernelSize = 16;
+// Наибольший размер, для которого определитель и дополнения считаются
+// по явным формулам
+constexpr int kS21ClosedFormSize = 4;
+
+// c = a * b для a размера rows x k и b размера k x n
+using S21SmallMulKernel = void (*)(const double *const *a,
+                                   const double *const *b, double *const *c,
+                                   int rows);
+
+// Ядро умножения для внутреннего размера k и числа столбцов n или nullptr,
+// если такого ядра нет
+S21SmallMulKernel S21FindSmallMul(int k, int n);
+
+// Определитель квадратной матрицы n x n, n <= kS21ClosedFormSize
+double S21SmallDeterminant(const double *const *a, int n);
+
+// Алгебраические дополнения n x n, n <= kS21ClosedFormSize, записываются
+// по строкам в cofactors
+void S21SmallCofactors(const double *const *a, int n, double *cofactors);
+
+#endif  // S21_SMALL_KERNELS_H
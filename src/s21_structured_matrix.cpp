@@ -0,0 +1,590 @@
+#include "s21_structured_matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "s21_tiled_factorization.h"
+
+namespace {
+
+// Symmetric matrices from this size on use the tiled Cholesky.
+constexpr int kTiledThreshold = 256;
+constexpr int kTileSize = 64;
+
+void CheckSize(int size) {
+  if (size <= 0) {
+    throw std::invalid_argument("Invalid matrix size");
+  }
+}
+
+void CheckSquare(const S21Matrix &matrix) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::invalid_argument("Matrix must be square");
+  }
+}
+
+void CheckRows(const S21Matrix &other, int size) {
+  if (other.GetRows() != size) {
+    throw std::invalid_argument(
+        "Number of columns in the first matrix must match number of rows in "
+        "the second matrix");
+  }
+}
+
+void CheckIndex(int i, int j, int size) {
+  if (i < 0 || i >= size || j < 0 || j >= size) {
+    throw std::out_of_range("Index out of range");
+  }
+}
+
+void RequireStructure(bool ok) {
+  if (!ok) {
+    throw std::invalid_argument("Matrix does not have the requested structure");
+  }
+}
+
+void ThrowSingular() {
+  throw std::invalid_argument("Matrix is singular and cannot be inverted");
+}
+
+// row_out += factor * row_in over cols elements.
+void Axpy(double *row_out, const double *row_in, double factor, int cols) {
+  for (int c = 0; c < cols; ++c) row_out[c] += factor * row_in[c];
+}
+
+}  // namespace
+
+// S21DiagonalMatrix
+
+S21DiagonalMatrix::S21DiagonalMatrix(int size) : size_(size) {
+  CheckSize(size);
+  diag_.assign(size, 0.0);
+}
+
+S21DiagonalMatrix S21DiagonalMatrix::FromMatrix(const S21Matrix &matrix) {
+  CheckSquare(matrix);
+  S21DiagonalMatrix result(matrix.GetRows());
+  for (int i = 0; i < result.size_; ++i) {
+    const double *row = matrix.RowData(i);
+    for (int j = 0; j < result.size_; ++j) {
+      if (i == j) {
+        result.diag_[i] = row[j];
+      } else {
+        RequireStructure(fabs(row[j]) <= S21_EPS);
+      }
+    }
+  }
+  return result;
+}
+
+S21Matrix S21DiagonalMatrix::ToMatrix() const {
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; ++i) result(i, i) = diag_[i];
+  return result;
+}
+
+int S21DiagonalMatrix::GetSize() const { return size_; }
+
+double S21DiagonalMatrix::operator()(int i, int j) const {
+  CheckIndex(i, j, size_);
+  return i == j ? diag_[i] : 0.0;
+}
+
+double &S21DiagonalMatrix::At(int i, int j) {
+  CheckIndex(i, j, size_);
+  if (i != j) throw std::out_of_range("Index out of range");
+  return diag_[i];
+}
+
+S21Matrix S21DiagonalMatrix::Multiply(const S21Matrix &other) const {
+  CheckRows(other, size_);
+  const int cols = other.GetCols();
+  S21Matrix result(size_, cols, S21Uninitialized);
+  for (int i = 0; i < size_; ++i) {
+    const double *in = other.RowData(i);
+    double *out = result.RowData(i);
+    for (int c = 0; c < cols; ++c) out[c] = diag_[i] * in[c];
+  }
+  return result;
+}
+
+S21Matrix S21DiagonalMatrix::Solve(const S21Matrix &rhs) const {
+  CheckRows(rhs, size_);
+  return InverseMatrix().Multiply(rhs);
+}
+
+double S21DiagonalMatrix::Determinant() const {
+  double det = 1.0;
+  for (double value : diag_) det *= value;
+  return det;
+}
+
+S21DiagonalMatrix S21DiagonalMatrix::InverseMatrix() const {
+  S21DiagonalMatrix result(size_);
+  for (int i = 0; i < size_; ++i) {
+    if (fabs(diag_[i]) < S21_EPS) ThrowSingular();
+    result.diag_[i] = 1.0 / diag_[i];
+  }
+  return result;
+}
+
+// S21TriangularMatrix
+
+S21TriangularMatrix::S21TriangularMatrix(int size, Shape shape)
+    : size_(size), shape_(shape) {
+  CheckSize(size);
+  packed_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+bool S21TriangularMatrix::Stored(int i, int j) const {
+  return shape_ == kUpper ? j >= i : j <= i;
+}
+
+size_t S21TriangularMatrix::Index(int i, int j) const {
+  size_t row = i;
+  if (shape_ == kUpper) {
+    return row * size_ - row * (row - 1) / 2 + (j - i);
+  }
+  return row * (row + 1) / 2 + j;
+}
+
+S21TriangularMatrix S21TriangularMatrix::FromMatrix(const S21Matrix &matrix,
+                                                    Shape shape) {
+  CheckSquare(matrix);
+  S21TriangularMatrix result(matrix.GetRows(), shape);
+  for (int i = 0; i < result.size_; ++i) {
+    const double *row = matrix.RowData(i);
+    for (int j = 0; j < result.size_; ++j) {
+      if (result.Stored(i, j)) {
+        result.packed_[result.Index(i, j)] = row[j];
+      } else {
+        RequireStructure(fabs(row[j]) <= S21_EPS);
+      }
+    }
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::ToMatrix() const {
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; ++i) {
+    double *row = result.RowData(i);
+    for (int j = 0; j < size_; ++j) {
+      if (Stored(i, j)) row[j] = packed_[Index(i, j)];
+    }
+  }
+  return result;
+}
+
+int S21TriangularMatrix::GetSize() const { return size_; }
+
+S21TriangularMatrix::Shape S21TriangularMatrix::GetShape() const {
+  return shape_;
+}
+
+double S21TriangularMatrix::operator()(int i, int j) const {
+  CheckIndex(i, j, size_);
+  return Stored(i, j) ? packed_[Index(i, j)] : 0.0;
+}
+
+double &S21TriangularMatrix::At(int i, int j) {
+  CheckIndex(i, j, size_);
+  if (!Stored(i, j)) throw std::out_of_range("Index out of range");
+  return packed_[Index(i, j)];
+}
+
+S21Matrix S21TriangularMatrix::Multiply(const S21Matrix &other) const {
+  CheckRows(other, size_);
+  const int cols = other.GetCols();
+  S21Matrix result(size_, cols);
+  for (int i = 0; i < size_; ++i) {
+    double *out = result.RowData(i);
+    int begin = shape_ == kUpper ? i : 0;
+    int end = shape_ == kUpper ? size_ : i + 1;
+    for (int j = begin; j < end; ++j) {
+      Axpy(out, other.RowData(j), packed_[Index(i, j)], cols);
+    }
+  }
+  return result;
+}
+
+S21Matrix S21TriangularMatrix::Solve(const S21Matrix &rhs) const {
+  CheckRows(rhs, size_);
+  const int cols = rhs.GetCols();
+  S21Matrix result(rhs);
+  for (int step = 0; step < size_; ++step) {
+    int i = shape_ == kLower ? step : size_ - 1 - step;
+    double *x = result.RowData(i);
+    int begin = shape_ == kLower ? 0 : i + 1;
+    int end = shape_ == kLower ? i : size_;
+    for (int j = begin; j < end; ++j) {
+      Axpy(x, result.RowData(j), -packed_[Index(i, j)], cols);
+    }
+    double diag = packed_[Index(i, i)];
+    if (fabs(diag) < S21_EPS) ThrowSingular();
+    for (int c = 0; c < cols; ++c) x[c] /= diag;
+  }
+  return result;
+}
+
+double S21TriangularMatrix::Determinant() const {
+  double det = 1.0;
+  for (int i = 0; i < size_; ++i) det *= packed_[Index(i, i)];
+  return det;
+}
+
+// Column j of the inverse is nonzero only inside the triangle, so each
+// column costs O((n - j)^2) for lower and O(j^2) for upper matrices.
+S21TriangularMatrix S21TriangularMatrix::InverseMatrix() const {
+  for (int i = 0; i < size_; ++i) {
+    if (fabs(packed_[Index(i, i)]) < S21_EPS) ThrowSingular();
+  }
+
+  S21TriangularMatrix result(size_, shape_);
+  for (int j = 0; j < size_; ++j) {
+    result.packed_[Index(j, j)] = 1.0 / packed_[Index(j, j)];
+    if (shape_ == kLower) {
+      for (int i = j + 1; i < size_; ++i) {
+        double sum = 0.0;
+        for (int k = j; k < i; ++k) {
+          sum += packed_[Index(i, k)] * result.packed_[Index(k, j)];
+        }
+        result.packed_[Index(i, j)] = -sum / packed_[Index(i, i)];
+      }
+    } else {
+      for (int i = j - 1; i >= 0; --i) {
+        double sum = 0.0;
+        for (int k = i + 1; k <= j; ++k) {
+          sum += packed_[Index(i, k)] * result.packed_[Index(k, j)];
+        }
+        result.packed_[Index(i, j)] = -sum / packed_[Index(i, i)];
+      }
+    }
+  }
+  return result;
+}
+
+// S21SymmetricMatrix
+
+S21SymmetricMatrix::S21SymmetricMatrix(int size) : size_(size) {
+  CheckSize(size);
+  packed_.assign(static_cast<size_t>(size) * (size + 1) / 2, 0.0);
+}
+
+size_t S21SymmetricMatrix::Index(int i, int j) const {
+  if (i < j) std::swap(i, j);
+  return static_cast<size_t>(i) * (i + 1) / 2 + j;
+}
+
+S21SymmetricMatrix S21SymmetricMatrix::FromMatrix(const S21Matrix &matrix) {
+  CheckSquare(matrix);
+  S21SymmetricMatrix result(matrix.GetRows());
+  for (int i = 0; i < result.size_; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      RequireStructure(fabs(matrix(i, j) - matrix(j, i)) <= S21_EPS);
+      result.packed_[result.Index(i, j)] = matrix(i, j);
+    }
+  }
+  return result;
+}
+
+S21Matrix S21SymmetricMatrix::ToMatrix() const {
+  S21Matrix result(size_, size_, S21Uninitialized);
+  for (int i = 0; i < size_; ++i) {
+    double *row = result.RowData(i);
+    for (int j = 0; j < size_; ++j) row[j] = packed_[Index(i, j)];
+  }
+  return result;
+}
+
+int S21SymmetricMatrix::GetSize() const { return size_; }
+
+double S21SymmetricMatrix::operator()(int i, int j) const {
+  CheckIndex(i, j, size_);
+  return packed_[Index(i, j)];
+}
+
+double &S21SymmetricMatrix::At(int i, int j) {
+  CheckIndex(i, j, size_);
+  return packed_[Index(i, j)];
+}
+
+S21Matrix S21SymmetricMatrix::Multiply(const S21Matrix &other) const {
+  CheckRows(other, size_);
+  const int cols = other.GetCols();
+  S21Matrix result(size_, cols);
+  for (int i = 0; i < size_; ++i) {
+    double *out_i = result.RowData(i);
+    const double *in_i = other.RowData(i);
+    for (int j = 0; j < i; ++j) {
+      double value = packed_[Index(i, j)];
+      Axpy(out_i, other.RowData(j), value, cols);
+      Axpy(result.RowData(j), in_i, value, cols);
+    }
+    Axpy(out_i, in_i, packed_[Index(i, i)], cols);
+  }
+  return result;
+}
+
+bool S21SymmetricMatrix::Cholesky(std::vector<double> &factor) const {
+  if (size_ >= kTiledThreshold) {
+    const size_t n = size_;
+    std::vector<double> dense(n * n, 0.0);
+    for (int i = 0; i < size_; ++i) {
+      for (int j = 0; j <= i; ++j) dense[i * n + j] = packed_[Index(i, j)];
+    }
+    if (!S21TiledCholesky(dense.data(), size_, kTileSize,
+                          S21Matrix::GetMaxThreads())) {
+      return false;
+    }
+    factor.assign(packed_.size(), 0.0);
+    for (int i = 0; i < size_; ++i) {
+      for (int j = 0; j <= i; ++j) factor[Index(i, j)] = dense[i * n + j];
+    }
+    return true;
+  }
+
+  factor.assign(packed_.size(), 0.0);
+  for (int j = 0; j < size_; ++j) {
+    double diag = packed_[Index(j, j)];
+    for (int k = 0; k < j; ++k) {
+      diag -= factor[Index(j, k)] * factor[Index(j, k)];
+    }
+    if (diag <= 0.0) return false;
+    double ljj = std::sqrt(diag);
+    factor[Index(j, j)] = ljj;
+    for (int i = j + 1; i < size_; ++i) {
+      double sum = packed_[Index(i, j)];
+      for (int k = 0; k < j; ++k) {
+        sum -= factor[Index(i, k)] * factor[Index(j, k)];
+      }
+      factor[Index(i, j)] = sum / ljj;
+    }
+  }
+  return true;
+}
+
+double S21SymmetricMatrix::Determinant() const {
+  std::vector<double> factor;
+  if (!Cholesky(factor)) return ToMatrix().Determinant();
+  double det = 1.0;
+  for (int i = 0; i < size_; ++i) det *= factor[Index(i, i)];
+  return det * det;
+}
+
+S21SymmetricMatrix S21SymmetricMatrix::InverseMatrix() const {
+  S21SymmetricMatrix result(size_);
+  std::vector<double> factor;
+  bool definite = Cholesky(factor);
+  for (int i = 0; definite && i < size_; ++i) {
+    definite = factor[Index(i, i)] >= S21_EPS;
+  }
+
+  if (!definite) {
+    S21Matrix inverse = ToMatrix().InverseMatrix();
+    for (int i = 0; i < size_; ++i) {
+      for (int j = 0; j <= i; ++j) {
+        result.packed_[Index(i, j)] = 0.5 * (inverse(i, j) + inverse(j, i));
+      }
+    }
+    return result;
+  }
+
+  // A^-1 = L^-T * L^-1 with L^-1 lower triangular, stored row-major in the
+  // same packed layout as L.
+  S21TriangularMatrix lower(size_, S21TriangularMatrix::kLower);
+  for (int i = 0; i < size_; ++i) {
+    for (int j = 0; j <= i; ++j) lower.At(i, j) = factor[Index(i, j)];
+  }
+  S21TriangularMatrix lower_inv = lower.InverseMatrix();
+  for (int i = 0; i < size_; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      double sum = 0.0;
+      for (int k = i; k < size_; ++k) {
+        sum += lower_inv(k, i) * lower_inv(k, j);
+      }
+      result.packed_[Index(i, j)] = sum;
+    }
+  }
+  return result;
+}
+
+// S21BandedMatrix
+
+S21BandedMatrix::S21BandedMatrix(int size, int lower, int upper)
+    : size_(size), lower_(lower), upper_(upper) {
+  CheckSize(size);
+  if (lower < 0 || upper < 0) {
+    throw std::invalid_argument("Invalid bandwidth");
+  }
+  band_.assign(static_cast<size_t>(size) * (lower + upper + 1), 0.0);
+}
+
+bool S21BandedMatrix::Stored(int i, int j) const {
+  return j >= i - lower_ && j <= i + upper_;
+}
+
+size_t S21BandedMatrix::Index(int i, int j) const {
+  return static_cast<size_t>(i) * (lower_ + upper_ + 1) + (j - i + lower_);
+}
+
+S21BandedMatrix S21BandedMatrix::FromMatrix(const S21Matrix &matrix,
+                                            int lower, int upper) {
+  CheckSquare(matrix);
+  S21BandedMatrix result(matrix.GetRows(), lower, upper);
+  for (int i = 0; i < result.size_; ++i) {
+    const double *row = matrix.RowData(i);
+    for (int j = 0; j < result.size_; ++j) {
+      if (result.Stored(i, j)) {
+        result.band_[result.Index(i, j)] = row[j];
+      } else {
+        RequireStructure(fabs(row[j]) <= S21_EPS);
+      }
+    }
+  }
+  return result;
+}
+
+S21Matrix S21BandedMatrix::ToMatrix() const {
+  S21Matrix result(size_, size_);
+  for (int i = 0; i < size_; ++i) {
+    double *row = result.RowData(i);
+    int end = std::min(size_ - 1, i + upper_);
+    for (int j = std::max(0, i - lower_); j <= end; ++j) {
+      row[j] = band_[Index(i, j)];
+    }
+  }
+  return result;
+}
+
+int S21BandedMatrix::GetSize() const { return size_; }
+
+int S21BandedMatrix::GetLower() const { return lower_; }
+
+int S21BandedMatrix::GetUpper() const { return upper_; }
+
+double S21BandedMatrix::operator()(int i, int j) const {
+  CheckIndex(i, j, size_);
+  return Stored(i, j) ? band_[Index(i, j)] : 0.0;
+}
+
+double &S21BandedMatrix::At(int i, int j) {
+  CheckIndex(i, j, size_);
+  if (!Stored(i, j)) throw std::out_of_range("Index out of range");
+  return band_[Index(i, j)];
+}
+
+S21Matrix S21BandedMatrix::Multiply(const S21Matrix &other) const {
+  CheckRows(other, size_);
+  const int cols = other.GetCols();
+  S21Matrix result(size_, cols);
+  for (int i = 0; i < size_; ++i) {
+    double *out = result.RowData(i);
+    int end = std::min(size_ - 1, i + upper_);
+    for (int j = std::max(0, i - lower_); j <= end; ++j) {
+      Axpy(out, other.RowData(j), band_[Index(i, j)], cols);
+    }
+  }
+  return result;
+}
+
+// Row i of the work array covers columns [i - lower, i + lower + upper]:
+// row swaps with partial pivoting widen U by lower superdiagonals. The
+// multipliers of step k stay where they were computed (as in LAPACK gbtf2),
+// so Solve replays swaps and eliminations in the same order.
+bool S21BandedMatrix::Factorize(std::vector<double> &lu,
+                                std::vector<int> &pivots, int &sign) const {
+  const int width = 2 * lower_ + upper_ + 1;
+  auto at = [&](int i, int j) -> double & {
+    return lu[static_cast<size_t>(i) * width + (j - i + lower_)];
+  };
+
+  lu.assign(static_cast<size_t>(size_) * width, 0.0);
+  pivots.assign(size_, 0);
+  for (int i = 0; i < size_; ++i) {
+    int end = std::min(size_ - 1, i + upper_);
+    for (int j = std::max(0, i - lower_); j <= end; ++j) {
+      at(i, j) = band_[Index(i, j)];
+    }
+  }
+
+  bool regular = true;
+  sign = 1;
+  for (int k = 0; k < size_; ++k) {
+    int last_row = std::min(size_ - 1, k + lower_);
+    int last_col = std::min(size_ - 1, k + lower_ + upper_);
+    int pivot = k;
+    for (int i = k + 1; i <= last_row; ++i) {
+      if (fabs(at(i, k)) > fabs(at(pivot, k))) pivot = i;
+    }
+    pivots[k] = pivot;
+    if (pivot != k) {
+      for (int j = k; j <= last_col; ++j) std::swap(at(k, j), at(pivot, j));
+      sign = -sign;
+    }
+
+    double diag = at(k, k);
+    if (fabs(diag) < S21_EPS) regular = false;
+    if (diag == 0.0) continue;
+    for (int i = k + 1; i <= last_row; ++i) {
+      double factor = at(i, k) / diag;
+      at(i, k) = factor;
+      for (int j = k + 1; j <= last_col; ++j) at(i, j) -= factor * at(k, j);
+    }
+  }
+  return regular;
+}
+
+S21Matrix S21BandedMatrix::Solve(const S21Matrix &rhs) const {
+  CheckRows(rhs, size_);
+  std::vector<double> lu;
+  std::vector<int> pivots;
+  int sign = 1;
+  if (!Factorize(lu, pivots, sign)) ThrowSingular();
+
+  const int width = 2 * lower_ + upper_ + 1;
+  auto at = [&](int i, int j) {
+    return lu[static_cast<size_t>(i) * width + (j - i + lower_)];
+  };
+  const int cols = rhs.GetCols();
+  S21Matrix result(rhs);
+  for (int k = 0; k < size_; ++k) {
+    double *x_k = result.RowData(k);
+    if (pivots[k] != k) {
+      std::swap_ranges(x_k, x_k + cols, result.RowData(pivots[k]));
+    }
+    int last_row = std::min(size_ - 1, k + lower_);
+    for (int i = k + 1; i <= last_row; ++i) {
+      Axpy(result.RowData(i), x_k, -at(i, k), cols);
+    }
+  }
+  for (int i = size_ - 1; i >= 0; --i) {
+    double *x_i = result.RowData(i);
+    int last_col = std::min(size_ - 1, i + lower_ + upper_);
+    for (int j = i + 1; j <= last_col; ++j) {
+      Axpy(x_i, result.RowData(j), -at(i, j), cols);
+    }
+    double diag = at(i, i);
+    for (int c = 0; c < cols; ++c) x_i[c] /= diag;
+  }
+  return result;
+}
+
+double S21BandedMatrix::Determinant() const {
+  std::vector<double> lu;
+  std::vector<int> pivots;
+  int sign = 1;
+  Factorize(lu, pivots, sign);
+
+  const size_t width = 2 * lower_ + upper_ + 1;
+  double det = sign;
+  for (int i = 0; i < size_; ++i) det *= lu[i * width + lower_];
+  return det;
+}
+
+S21Matrix S21BandedMatrix::InverseMatrix() const {
+  S21Matrix identity(size_, size_);
+  for (int i = 0; i < size_; ++i) identity(i, i) = 1.0;
+  return Solve(identity);
+}
@@ -0,0 +1,121 @@
+#ifndef S21_STRUCTURED_MATRIX_H
+#define S21_STRUCTURED_MATRIX_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Матрицы со структурой хранят только значимые элементы.
+// operator()(i, j) возвращает значение любого элемента (вне структуры - 0),
+// At(i, j) - ссылку на хранимый элемент или std::out_of_range.
+
+// Диагональная матрица
+class S21DiagonalMatrix {
+ private:
+  int size_;
+  std::vector<double> diag_;
+
+ public:
+  explicit S21DiagonalMatrix(int size);
+  static S21DiagonalMatrix FromMatrix(const S21Matrix &matrix);
+  S21Matrix ToMatrix() const;
+
+  int GetSize() const;
+  double operator()(int i, int j) const;
+  double &At(int i, int j);
+
+  S21Matrix Multiply(const S21Matrix &other) const;  // this * other
+  S21Matrix Solve(const S21Matrix &rhs) const;       // this * X = rhs
+  double Determinant() const;
+  S21DiagonalMatrix InverseMatrix() const;
+};
+
+// Верхне- или нижнетреугольная матрица в упакованном виде, n(n+1)/2
+class S21TriangularMatrix {
+ public:
+  enum Shape { kUpper, kLower };
+
+ private:
+  int size_;
+  Shape shape_;
+  std::vector<double> packed_;
+
+  bool Stored(int i, int j) const;
+  size_t Index(int i, int j) const;
+
+ public:
+  S21TriangularMatrix(int size, Shape shape);
+  static S21TriangularMatrix FromMatrix(const S21Matrix &matrix, Shape shape);
+  S21Matrix ToMatrix() const;
+
+  int GetSize() const;
+  Shape GetShape() const;
+  double operator()(int i, int j) const;
+  double &At(int i, int j);
+
+  S21Matrix Multiply(const S21Matrix &other) const;
+  S21Matrix Solve(const S21Matrix &rhs) const;  // Прямая/обратная подстановка
+  double Determinant() const;
+  S21TriangularMatrix InverseMatrix() const;
+};
+
+// Симметричная матрица, хранится нижний треугольник в упакованном виде
+class S21SymmetricMatrix {
+ private:
+  int size_;
+  std::vector<double> packed_;
+
+  size_t Index(int i, int j) const;
+  // Разложение Холецкого в упакованном виде, false если матрица
+  // не положительно определена
+  bool Cholesky(std::vector<double> &factor) const;
+
+ public:
+  explicit S21SymmetricMatrix(int size);
+  static S21SymmetricMatrix FromMatrix(const S21Matrix &matrix);
+  S21Matrix ToMatrix() const;
+
+  int GetSize() const;
+  double operator()(int i, int j) const;
+  double &At(int i, int j);  // Ссылка на общий элемент (i, j) и (j, i)
+
+  S21Matrix Multiply(const S21Matrix &other) const;
+  // Для положительно определенных матриц через разложение Холецкого,
+  // иначе через LU-разложение полной матрицы
+  double Determinant() const;
+  S21SymmetricMatrix InverseMatrix() const;
+};
+
+// Ленточная матрица с lower поддиагоналями и upper наддиагоналями
+class S21BandedMatrix {
+ private:
+  int size_, lower_, upper_;
+  std::vector<double> band_;  // Строка i хранит столбцы [i - lower, i + upper]
+
+  bool Stored(int i, int j) const;
+  size_t Index(int i, int j) const;
+  // LU-разложение с выбором ведущего элемента за O(n * lower * (lower +
+  // upper)). Наддиагональная ширина U растет до lower + upper.
+  bool Factorize(std::vector<double> &lu, std::vector<int> &pivots,
+                 int &sign) const;
+
+ public:
+  S21BandedMatrix(int size, int lower, int upper);
+  static S21BandedMatrix FromMatrix(const S21Matrix &matrix, int lower,
+                                    int upper);
+  S21Matrix ToMatrix() const;
+
+  int GetSize() const;
+  int GetLower() const;
+  int GetUpper() const;
+  double operator()(int i, int j) const;
+  double &At(int i, int j);
+
+  S21Matrix Multiply(const S21Matrix &other) const;
+  S21Matrix Solve(const S21Matrix &rhs) const;
+  double Determinant() const;
+  // Обратная к ленточной матрице в общем случае полная
+  S21Matrix InverseMatrix() const;
+};
+
+#endif  // S21_STRUCTURED_MATRIX_H
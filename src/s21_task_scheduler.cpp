@@ -0,0 +1,206 @@
+#include "s21_task_scheduler.h"
+
+#include <algorithm>
+
+namespace {
+
+// Failed Pop() attempts a participant yields through before it sleeps.
+constexpr int kSpinRounds = 64;
+
+}  // namespace
+
+// S21TaskGraph
+
+int S21TaskGraph::Add(std::function<void()> task, bool urgent) {
+  Node node;
+  node.task = std::move(task);
+  node.urgent = urgent;
+  nodes_.push_back(std::move(node));
+  return static_cast<int>(nodes_.size()) - 1;
+}
+
+void S21TaskGraph::Depend(int before, int after) {
+  nodes_[before].next.push_back(after);
+  ++nodes_[after].deps;
+}
+
+size_t S21TaskGraph::Size() const { return nodes_.size(); }
+
+// S21TaskScheduler
+
+S21TaskScheduler::S21TaskScheduler(int threads) {
+  threads = std::max(threads, 1);
+  for (int i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (int i = 1; i < threads; ++i) {
+    workers_.emplace_back(&S21TaskScheduler::WorkerLoop, this, i);
+  }
+}
+
+S21TaskScheduler::~S21TaskScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_cv_.notify_all();
+  for (std::thread &worker : workers_) worker.join();
+}
+
+S21TaskScheduler &S21TaskScheduler::Instance() {
+  static S21TaskScheduler scheduler(
+      static_cast<int>(std::thread::hardware_concurrency()));
+  return scheduler;
+}
+
+int S21TaskScheduler::GetThreadCount() const {
+  return static_cast<int>(queues_.size());
+}
+
+uint64_t S21TaskScheduler::GetSteals() const {
+  return steals_.load(std::memory_order_relaxed);
+}
+
+void S21TaskScheduler::Run(S21TaskGraph &graph, int threads) {
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  const size_t size = graph.nodes_.size();
+  if (size == 0) return;
+
+  graph_ = &graph;
+  participants_ = std::clamp(threads, 1, GetThreadCount());
+  pending_.reset(new std::atomic<int>[size]);
+  for (size_t i = 0; i < size; ++i) {
+    pending_[i].store(graph.nodes_[i].deps, std::memory_order_relaxed);
+  }
+  unfinished_.store(size);
+  error_ = nullptr;
+
+  int target = 0;
+  for (size_t i = 0; i < size; ++i) {
+    if (graph.nodes_[i].deps == 0) {
+      Push(target, static_cast<int>(i));
+      target = (target + 1) % participants_;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    active_workers_ = participants_ - 1;
+    ++generation_;
+  }
+  wake_cv_.notify_all();
+
+  Participate(0);
+  // Workers may still be inside Pop() after the last task finished.
+  {
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    done_cv_.wait(lock, [this] { return active_workers_ == 0; });
+  }
+  graph_ = nullptr;
+
+  if (error_) std::rethrow_exception(error_);
+}
+
+void S21TaskScheduler::WorkerLoop(int index) {
+  uint64_t seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      wake_cv_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+    }
+    if (index < participants_) {
+      Participate(index);
+      std::lock_guard<std::mutex> lock(wake_mutex_);
+      if (--active_workers_ == 0) done_cv_.notify_one();
+    }
+  }
+}
+
+// Spins briefly when no task is ready, then sleeps until Push() or the
+// last task wakes it, so idle participants do not burn a core while one
+// thread works through a long task such as a panel factorization.
+void S21TaskScheduler::Participate(int index) {
+  int task = 0;
+  int idle = 0;
+  while (unfinished_.load() > 0) {
+    // Read before Pop(), so a push racing with a failed Pop() is noticed.
+    const uint64_t pushes = pushes_.load();
+    if (Pop(index, task)) {
+      Execute(index, task);
+      idle = 0;
+    } else if (++idle < kSpinRounds) {
+      std::this_thread::yield();
+    } else {
+      sleepers_.fetch_add(1);
+      {
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        idle_cv_.wait(lock, [&] {
+          return unfinished_.load() == 0 || pushes_.load() != pushes;
+        });
+      }
+      sleepers_.fetch_sub(1);
+      idle = 0;
+    }
+  }
+}
+
+bool S21TaskScheduler::Pop(int index, int &task) {
+  {
+    Queue &own = *queues_[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = own.tasks.back();
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+  for (int offset = 1; offset < participants_; ++offset) {
+    Queue &victim = *queues_[(index + offset) % participants_];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = victim.tasks.front();
+      victim.tasks.pop_front();
+      steals_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Urgent tasks go to the end the owner pops next; the rest go to the end
+// thieves take from.
+void S21TaskScheduler::Push(int index, int task) {
+  Queue &queue = *queues_[index];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (graph_->nodes_[task].urgent) {
+      queue.tasks.push_back(task);
+    } else {
+      queue.tasks.push_front(task);
+    }
+  }
+  pushes_.fetch_add(1);
+  if (sleepers_.load() > 0) {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    idle_cv_.notify_one();
+  }
+}
+
+void S21TaskScheduler::Execute(int index, int task) {
+  const S21TaskGraph::Node &node = graph_->nodes_[task];
+  try {
+    node.task();
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (!error_) error_ = std::current_exception();
+  }
+  for (int next : node.next) {
+    if (pending_[next].fetch_sub(1) == 1) Push(index, next);
+  }
+  if (unfinished_.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> lock(idle_mutex_);
+    idle_cv_.notify_all();
+  }
+}
@@ -0,0 +1,91 @@
+#ifndef S21_TASK_SCHEDULER_H
+#define S21_TASK_SCHEDULER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Граф задач с явными зависимостями
+class S21TaskGraph {
+ public:
+  // urgent - задача на критическом пути, выполняется раньше остальных
+  int Add(std::function<void()> task, bool urgent = false);
+  void Depend(int before, int after);  // after ждет завершения before
+  size_t Size() const;
+
+ private:
+  friend class S21TaskScheduler;
+  struct Node {
+    std::function<void()> task;
+    std::vector<int> next;
+    int deps = 0;
+    bool urgent = false;
+  };
+  std::vector<Node> nodes_;
+};
+
+// Планировщик с перехватом работы. У каждого потока своя очередь: владелец
+// берет задачи с конца, свободные потоки забирают их с начала чужих очередей.
+// Вызывающий Run поток сам участвует в выполнении графа.
+class S21TaskScheduler {
+ public:
+  explicit S21TaskScheduler(int threads);
+  ~S21TaskScheduler();
+  S21TaskScheduler(const S21TaskScheduler &) = delete;
+  S21TaskScheduler &operator=(const S21TaskScheduler &) = delete;
+
+  static S21TaskScheduler &Instance();
+
+  // Выполняет граф не более чем threads потоками и ждет его завершения.
+  // Одновременные вызовы Run выполняются по очереди.
+  void Run(S21TaskGraph &graph, int threads);
+  int GetThreadCount() const;
+  uint64_t GetSteals() const;
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<int> tasks;
+  };
+
+  void WorkerLoop(int index);
+  void Participate(int index);
+  bool Pop(int index, int &task);
+  void Push(int index, int task);
+  void Execute(int index, int task);
+
+  std::vector<std::thread> workers_;
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::mutex run_mutex_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_cv_;
+  uint64_t generation_ = 0;
+  bool stop_ = false;
+
+  // Состояние текущего запуска
+  S21TaskGraph *graph_ = nullptr;
+  int participants_ = 0;
+  std::unique_ptr<std::atomic<int>[]> pending_;
+  std::atomic<size_t> unfinished_{0};
+  int active_workers_ = 0;  // Под wake_mutex_
+  std::condition_variable done_cv_;
+
+  // Потоки без задач засыпают до следующего Push или конца графа
+  std::mutex idle_mutex_;
+  std::condition_variable idle_cv_;
+  std::atomic<uint64_t> pushes_{0};
+  std::atomic<int> sleepers_{0};
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+  std::atomic<uint64_t> steals_{0};
+};
+
+#endif  // S21_TASK_SCHEDULER_H
@@ -1,6 +1,23 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "s21_matrix_async.h"
+#include "s21_matrix_autotune.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_profile.h"
+#include "s21_structured_matrix.h"
+#include "s21_task_scheduler.h"
+#include "s21_tiled_factorization.h"
 
 // Тесты для конструктора копирования
 TEST(S21MatrixTest, CopyConstructor) {
@@ -24,6 +41,18 @@ TEST(S21MatrixTest, MoveConstructor) {
   EXPECT_EQ(moved_matrix(1, 1), 2.0);
 }
 
+// Копирование матрицы после перемещения дает матрицу 0 x 0
+TEST(S21MatrixTest, CopyMovedFrom) {
+  S21Matrix matrix(3, 3);
+  S21Matrix moved(std::move(matrix));
+  S21Matrix copy(matrix);
+  EXPECT_EQ(copy.GetRows(), 0);
+  EXPECT_EQ(copy.GetCols(), 0);
+  moved = matrix;
+  EXPECT_EQ(moved.GetRows(), 0);
+  EXPECT_EQ(moved.GetCols(), 0);
+}
+
 // Тесты для оператора сложения
 TEST(S21MatrixTest, OperatorAddition) {
   S21Matrix matrix1(2, 2);
@@ -591,6 +620,1029 @@ TEST(S21MatrixTest, InverseMatrixThrowsErrorWhenNotSquare) {
   }
 }
 
+// Тесты для кэша производных величин
+TEST(S21MatrixTest, VersionBumpsOnMutation) {
+  S21Matrix matrix(2, 2);
+  uint64_t version = matrix.GetVersion();
+  matrix(0, 0) = 1.0;
+  EXPECT_GT(matrix.GetVersion(), version);
+
+  version = matrix.GetVersion();
+  matrix.MulNumber(2.0);
+  EXPECT_GT(matrix.GetVersion(), version);
+
+  version = matrix.GetVersion();
+  const S21Matrix& view = matrix;
+  EXPECT_EQ(view(0, 0), 2.0);
+  EXPECT_EQ(matrix.GetVersion(), version);
+}
+
+TEST(S21MatrixTest, DeterminantIsCached) {
+  S21Matrix matrix(4, 4);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      matrix(i, j) = (i == j) ? 2.0 : 1.0 / (i + j + 1);
+    }
+  }
+  double det = matrix.Determinant();
+  uint64_t hits = matrix.GetCacheHits();
+  uint64_t misses = matrix.GetCacheMisses();
+
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), det);
+  EXPECT_EQ(matrix.GetCacheHits(), hits + 1);
+  EXPECT_EQ(matrix.GetCacheMisses(), misses);
+
+  matrix(0, 0) = 3.0;
+  EXPECT_NE(matrix.Determinant(), det);
+  EXPECT_GT(matrix.GetCacheMisses(), misses);
+}
+
+TEST(S21MatrixTest, DeterminantLuMatchesCofactors) {
+  S21Matrix matrix(4, 4);
+  double values[4][4] = {
+      {2, -1, 0, 3}, {1, 4, -2, 0}, {0, 5, 1, -1}, {3, 0, 2, 1}};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      matrix(i, j) = values[i][j];
+    }
+  }
+
+  double expected = 0.0;
+  for (int j = 0; j < 4; ++j) {
+    expected += values[0][j] * matrix.CalcMinor(0, j).Determinant() *
+                ((j % 2 == 0) ? 1 : -1);
+  }
+  EXPECT_NEAR(matrix.Determinant(), expected, 1e-9);
+}
+
+TEST(S21MatrixTest, InverseIsCachedAndSurvivesCopy) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 2.0;
+  matrix(0, 1) = 1.0;
+  matrix(1, 1) = 3.0;
+  matrix(1, 2) = 1.0;
+  matrix(2, 0) = 1.0;
+  matrix(2, 2) = 4.0;
+
+  S21Matrix inverse = matrix.InverseMatrix();
+  S21Matrix product = matrix * inverse;
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-9);
+    }
+  }
+
+  S21Matrix copy(matrix);
+  uint64_t hits = copy.GetCacheHits();
+  EXPECT_TRUE(copy.InverseMatrix() == inverse);
+  EXPECT_EQ(copy.GetCacheHits(), hits + 1);
+}
+
+// Тесты для профилирования вызовов
+TEST(S21ProfilerTest, RecordsCallsWhenEnabled) {
+  S21Profiler::Reset();
+  S21Profiler::Enable(true);
+  S21Matrix a(3, 4);
+  S21Matrix b(4, 2);
+  a.MulMatrix(b);
+  a.MulNumber(2.0);
+  S21Profiler::Enable(false);
+  a.MulNumber(2.0);
+
+  std::vector<S21ProfileStats> stats = S21Profiler::Aggregate();
+  ASSERT_EQ(stats.size(), 2u);
+  for (const S21ProfileStats& entry : stats) {
+    EXPECT_EQ(entry.calls, 1u);
+    if (entry.name == "MulMatrix") {
+      EXPECT_DOUBLE_EQ(entry.flops, 2.0 * 3 * 4 * 2);
+      EXPECT_GT(entry.allocations, 0u);
+    }
+  }
+
+  std::string trace = S21Profiler::ChromeTrace();
+  EXPECT_NE(trace.find("\"traceEvents\""), std::string::npos);
+  EXPECT_NE(trace.find("\"name\":\"MulMatrix\""), std::string::npos);
+  EXPECT_NE(S21Profiler::Summary().find("MulNumber"), std::string::npos);
+
+  // События позже секунды от начала не теряют точность
+  S21Profiler::Reset();
+  S21Profiler::Enable(true);
+  { S21ProfileScope early("Early", 1, 1, 1e15 + 1, 0.0); }
+  std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+  { S21ProfileScope late("Late", 1, 1, 0.0, 0.0); }
+  S21Profiler::Enable(false);
+  trace = S21Profiler::ChromeTrace();
+  EXPECT_EQ(trace.find("e+"), std::string::npos);
+  EXPECT_NE(trace.find("\"flops\":1000000000000001"), std::string::npos);
+  size_t late = trace.find("\"ts\":", trace.find("\"name\":\"Late\""));
+  ASSERT_NE(late, std::string::npos);
+  std::string ts = trace.substr(late + 5, trace.find(',', late) - late - 5);
+  EXPECT_GT(std::stod(ts), 1.1e6);
+  EXPECT_EQ(ts.size() - ts.find('.'), 4u);
+
+  S21Profiler::Reset();
+  EXPECT_TRUE(S21Profiler::Collect().empty());
+}
+
+// Оценка операций Power и Exp учитывает выполненные умножения
+TEST(S21ProfilerTest, PowerAndExpCountMultiplies) {
+  S21Matrix matrix(4, 4);
+  for (int i = 0; i < 4; ++i) matrix(i, i) = 1.0 + i;
+  matrix(0, 3) = 10.0;
+  const double product = 2.0 * 4 * 4 * 4;
+
+  S21Profiler::Reset();
+  S21Profiler::Enable(true);
+  matrix.Power(13);  // 3 возведения в квадрат и 2 умножения
+  matrix.Exp();      // норма 11: 5 степеней, 5 возведений в квадрат
+  S21Profiler::Enable(false);
+  int found = 0;
+  for (const S21ProfileStats& entry : S21Profiler::Aggregate()) {
+    if (entry.name == "Power") {
+      EXPECT_DOUBLE_EQ(entry.flops, 5 * product);
+      ++found;
+    } else if (entry.name == "Exp") {
+      EXPECT_DOUBLE_EQ(entry.flops, 10 * product + 8.0 / 3.0 * 64);
+      ++found;
+    }
+  }
+  EXPECT_EQ(found, 2);
+  S21Profiler::Reset();
+}
+
+// Тесты для выделения памяти и многопоточных ядер
+TEST(S21MatrixTest, UninitializedConstructor) {
+  S21Matrix matrix(2, 3, S21Uninitialized);
+  EXPECT_EQ(matrix.GetRows(), 2);
+  EXPECT_EQ(matrix.GetCols(), 3);
+  EXPECT_THROW(S21Matrix(0, 3, S21Uninitialized), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, LargeMatrixIsZeroedAndCopied) {
+  S21Matrix::SetMaxThreads(4);
+  S21Matrix matrix(600, 600);
+  EXPECT_EQ(matrix(599, 599), 0.0);
+#ifdef __linux__
+  // Буфер выровнен по большой странице, иначе его не покрыть THP
+  const S21Matrix &view = matrix;
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(view.RowData(0)) % (size_t(2) << 20),
+            0u);
+#endif
+  matrix(0, 0) = 1.0;
+  matrix(599, 1) = 2.0;
+
+  S21Matrix copy(matrix);
+  copy.MulNumber(3.0);
+  copy.SumMatrix(matrix);
+  EXPECT_EQ(copy(0, 0), 4.0);
+  EXPECT_EQ(copy(599, 1), 8.0);
+
+  S21Matrix transposed = copy.Transpose();
+  EXPECT_EQ(transposed(1, 599), 8.0);
+  S21Matrix::SetMaxThreads(0);
+}
+
+TEST(S21MatrixTest, ThreadedMulMatrixMatchesSerial) {
+  S21Matrix a(70, 64);
+  S21Matrix b(64, 66);
+  for (int i = 0; i < 70; ++i) {
+    for (int j = 0; j < 64; ++j) a(i, j) = (i * 3 + j) % 7 - 3;
+  }
+  for (int i = 0; i < 64; ++i) {
+    for (int j = 0; j < 66; ++j) b(i, j) = (i + j * 5) % 11 - 5;
+  }
+
+  S21Matrix::SetMaxThreads(1);
+  S21Matrix serial = a * b;
+  S21Matrix::SetMaxThreads(3);
+  S21Matrix threaded = a * b;
+  // Привязка к ядрам включается только явно и не меняет результат
+  EXPECT_FALSE(S21Matrix::IsPinThreads());
+  S21Matrix::SetPinThreads(true);
+  S21Matrix pinned = a * b;
+  S21Matrix::SetPinThreads(false);
+  S21Matrix unpinned = a * b;
+  S21Matrix::SetMaxThreads(0);
+  EXPECT_TRUE(serial == threaded);
+  EXPECT_TRUE(serial == pinned);
+  EXPECT_TRUE(serial == unpinned);
+}
+
+// Тесты для асинхронного API
+TEST(S21AsyncTest, PipelineMatchesSynchronous) {
+  S21Matrix a(3, 3);
+  S21Matrix b(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      a(i, j) = (i == j) ? 3.0 : i - j;
+      b(i, j) = (i == j) ? 2.0 : 0.5 * (i + j);
+    }
+  }
+
+  S21Future<S21Matrix> product = MulMatrixAsync(a, b);
+  S21Future<S21Matrix> inverse = InverseAsync(product);
+  S21Future<double> det = DeterminantAsync(product);
+  S21Future<S21Matrix> identity = MulMatrixAsync(product, inverse);
+  S21Future<double> trace = identity.Then([](const S21Matrix& m) {
+    return m(0, 0) + m(1, 1) + m(2, 2);
+  });
+
+  S21Matrix expected = a * b;
+  EXPECT_TRUE(product.Get() == expected);
+  EXPECT_NEAR(det.Get(), expected.Determinant(), 1e-9);
+  EXPECT_NEAR(trace.Get(), 3.0, 1e-9);
+}
+
+TEST(S21AsyncTest, ErrorsPropagateThroughDependencies) {
+  S21Matrix singular(2, 2);
+  S21Future<S21Matrix> inverse = InverseAsync(singular);
+  S21Future<double> det = DeterminantAsync(inverse);
+  EXPECT_THROW(det.Get(), std::invalid_argument);
+}
+
+TEST(S21AsyncTest, SubmitCombinesSeveralInputs) {
+  S21Future<int> x = S21Submit([] { return 2; });
+  S21Future<int> y = S21MakeReady(5);
+  S21Future<int> sum =
+      S21Submit([](const int& left, const int& right) { return left + right; },
+                x, y);
+  EXPECT_EQ(sum.Get(), 7);
+  EXPECT_TRUE(sum.IsReady());
+}
+
+// Тесты для структурированных матриц
+static S21Matrix MakeDense(int rows, int cols, int seed) {
+  S21Matrix result(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      result(i, j) = ((i * 7 + j * 3 + seed) % 11) - 5.0;
+    }
+  }
+  return result;
+}
+
+static void ExpectNearMatrix(const S21Matrix& a, const S21Matrix& b) {
+  ASSERT_EQ(a.GetRows(), b.GetRows());
+  ASSERT_EQ(a.GetCols(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < a.GetCols(); ++j) {
+      EXPECT_NEAR(a(i, j), b(i, j), 1e-9) << i << ", " << j;
+    }
+  }
+}
+
+TEST(S21StructuredTest, DiagonalMatchesDense) {
+  S21DiagonalMatrix diag(4);
+  for (int i = 0; i < 4; ++i) diag.At(i, i) = i + 2.0;
+  S21Matrix dense = diag.ToMatrix();
+  S21Matrix other = MakeDense(4, 3, 1);
+
+  ExpectNearMatrix(diag.Multiply(other), dense * other);
+  EXPECT_DOUBLE_EQ(diag.Determinant(), 2.0 * 3.0 * 4.0 * 5.0);
+  ExpectNearMatrix(diag.InverseMatrix().ToMatrix(), dense.InverseMatrix());
+  ExpectNearMatrix(diag.Multiply(diag.Solve(other)), other);
+  EXPECT_THROW(diag.At(0, 1), std::out_of_range);
+  EXPECT_THROW(S21DiagonalMatrix::FromMatrix(other), std::invalid_argument);
+}
+
+TEST(S21StructuredTest, TriangularMatchesDense) {
+  for (auto shape :
+       {S21TriangularMatrix::kUpper, S21TriangularMatrix::kLower}) {
+    S21TriangularMatrix tri(5, shape);
+    for (int i = 0; i < 5; ++i) {
+      for (int j = 0; j < 5; ++j) {
+        if (shape == S21TriangularMatrix::kUpper ? j >= i : j <= i) {
+          tri.At(i, j) = (i == j) ? 3.0 + i : (i + 2 * j) % 5 - 2.0;
+        }
+      }
+    }
+    S21Matrix dense = tri.ToMatrix();
+    S21Matrix rhs = MakeDense(5, 2, 3);
+
+    ExpectNearMatrix(tri.Multiply(rhs), dense * rhs);
+    ExpectNearMatrix(dense * tri.Solve(rhs), rhs);
+    EXPECT_NEAR(tri.Determinant(), dense.Determinant(), 1e-9);
+    ExpectNearMatrix(tri.InverseMatrix().ToMatrix(), dense.InverseMatrix());
+    ExpectNearMatrix(S21TriangularMatrix::FromMatrix(dense, shape).ToMatrix(),
+                     dense);
+  }
+}
+
+TEST(S21StructuredTest, SymmetricMatchesDense) {
+  S21SymmetricMatrix spd(5);
+  S21SymmetricMatrix indefinite(5);
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      spd.At(i, j) = (i == j) ? 10.0 : 1.0 / (i + j + 1);
+      indefinite.At(i, j) = (i == j) ? (i % 2 ? -4.0 : 4.0) : 1.0;
+    }
+  }
+  EXPECT_EQ(spd(1, 3), spd(3, 1));
+
+  for (const S21SymmetricMatrix* sym : {&spd, &indefinite}) {
+    S21Matrix dense = sym->ToMatrix();
+    S21Matrix other = MakeDense(5, 4, 2);
+    ExpectNearMatrix(sym->Multiply(other), dense * other);
+    EXPECT_NEAR(sym->Determinant(), dense.Determinant(),
+                1e-9 * fabs(dense.Determinant()));
+    ExpectNearMatrix(sym->InverseMatrix().ToMatrix(), dense.InverseMatrix());
+  }
+  EXPECT_THROW(S21SymmetricMatrix::FromMatrix(MakeDense(3, 3, 1)),
+               std::invalid_argument);
+}
+
+TEST(S21StructuredTest, BandedMatchesDense) {
+  const int n = 9;
+  S21BandedMatrix band(n, 2, 1);
+  for (int i = 0; i < n; ++i) {
+    for (int j = std::max(0, i - 2); j <= std::min(n - 1, i + 1); ++j) {
+      // Small diagonal forces row swaps during factorization.
+      band.At(i, j) = (i == j) ? 0.5 : (i * 3 + j) % 7 - 3.0 + 0.25;
+    }
+  }
+  S21Matrix dense = band.ToMatrix();
+  S21Matrix rhs = MakeDense(n, 3, 5);
+
+  ExpectNearMatrix(band.Multiply(rhs), dense * rhs);
+  EXPECT_NEAR(band.Determinant(), dense.Determinant(),
+              1e-9 * fabs(dense.Determinant()));
+  ExpectNearMatrix(dense * band.Solve(rhs), rhs);
+  ExpectNearMatrix(band.InverseMatrix(), dense.InverseMatrix());
+  EXPECT_THROW(band.At(0, 3), std::out_of_range);
+  EXPECT_THROW(S21BandedMatrix(3, -1, 0), std::invalid_argument);
+  EXPECT_THROW(S21BandedMatrix::FromMatrix(dense, 1, 1), std::invalid_argument);
+}
+
+TEST(S21StructuredTest, SingularStructuredMatrices) {
+  S21DiagonalMatrix diag(3);
+  EXPECT_THROW(diag.InverseMatrix(), std::invalid_argument);
+  S21TriangularMatrix tri(3, S21TriangularMatrix::kLower);
+  EXPECT_DOUBLE_EQ(tri.Determinant(), 0.0);
+  EXPECT_THROW(tri.InverseMatrix(), std::invalid_argument);
+  S21BandedMatrix band(3, 1, 1);
+  EXPECT_DOUBLE_EQ(band.Determinant(), 0.0);
+  EXPECT_THROW(band.InverseMatrix(), std::invalid_argument);
+}
+
+// Тесты для режима копирования при записи
+TEST(S21MatrixTest, CopyOnWriteSharesUntilFirstWrite) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix original(3, 3);
+  original(1, 1) = 5.0;
+  // Изменяющий вызов делает выданные ссылки недействительными
+  original.MulNumber(1.0);
+
+  S21Matrix copy(original);
+  S21Matrix assigned;
+  assigned = original;
+  EXPECT_TRUE(original.IsShared());
+  EXPECT_TRUE(copy.IsShared());
+  const S21Matrix& view = copy;
+  EXPECT_EQ(view(1, 1), 5.0);
+  EXPECT_TRUE(copy.IsShared());
+
+  copy(1, 1) = 7.0;
+  EXPECT_FALSE(copy.IsShared());
+  EXPECT_EQ(original(1, 1), 5.0);
+  EXPECT_EQ(assigned(1, 1), 5.0);
+
+  S21Matrix sum = original + original;
+  EXPECT_EQ(sum(1, 1), 10.0);
+  EXPECT_EQ(original(1, 1), 5.0);
+  EXPECT_FALSE(original.IsShared());
+  EXPECT_FALSE(assigned.IsShared());
+  S21Matrix::SetCopyOnWrite(false);
+}
+
+TEST(S21MatrixTest, CopyOnWriteAcrossThreads) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix shared(40, 40);
+  for (int i = 0; i < 40; ++i) shared(i, i) = i + 1.0;
+
+  std::vector<std::thread> threads;
+  std::vector<double> traces(4);
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&shared, &traces, t]() {
+      for (int r = 0; r < 50; ++r) {
+        S21Matrix local(shared);
+        local.MulNumber(t + 1.0);
+        traces[t] = local(39, 39);
+      }
+    });
+  }
+  for (std::thread& thread : threads) thread.join();
+  for (int t = 0; t < 4; ++t) EXPECT_EQ(traces[t], 40.0 * (t + 1));
+  EXPECT_FALSE(shared.IsShared());
+  S21Matrix::SetCopyOnWrite(false);
+}
+
+// Копия не разделяет буфер, в который можно писать по выданной ссылке
+TEST(S21MatrixTest, CopyOnWriteKeepsHeldReferencesPrivate) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix x(2, 2);
+  double& r = x(0, 0);
+  S21Matrix w(x);
+  r = 42;
+  EXPECT_EQ(w(0, 0), 0.0);
+  EXPECT_EQ(x(0, 0), 42.0);
+
+  double* row = x.RowData(1);
+  S21Matrix v;
+  v = x;
+  row[1] = 7.0;
+  EXPECT_EQ(v(1, 1), 0.0);
+  EXPECT_EQ(x(1, 1), 7.0);
+
+  // После изменяющего вызова буфер снова разделяется
+  x.MulNumber(2.0);
+  S21Matrix shared(x);
+  EXPECT_TRUE(shared.IsShared());
+  EXPECT_EQ(shared(0, 0), 84.0);
+  S21Matrix::SetCopyOnWrite(false);
+}
+
+TEST(S21MatrixTest, CopyOnWriteCopiesMovedFrom) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix matrix(3, 3);
+  S21Matrix moved(std::move(matrix));
+  S21Matrix copy(matrix);
+  EXPECT_EQ(copy.GetRows(), 0);
+  EXPECT_FALSE(copy.IsShared());
+  S21Matrix::SetCopyOnWrite(false);
+}
+
+// Тесты для изменения размеров
+TEST(S21MatrixTest, SetRowsAndColsKeepElements) {
+  S21Matrix matrix(2, 3);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 3; ++j) matrix(i, j) = i * 10 + j;
+  }
+
+  matrix.SetCols(5);
+  EXPECT_EQ(matrix.GetCols(), 5);
+  EXPECT_EQ(matrix(1, 2), 12.0);
+  EXPECT_EQ(matrix(1, 4), 0.0);
+
+  matrix.SetRows(4);
+  EXPECT_EQ(matrix(1, 1), 11.0);
+  EXPECT_EQ(matrix(3, 4), 0.0);
+
+  size_t capacity = matrix.GetCapacity();
+  matrix.SetCols(2);
+  matrix.SetRows(1);
+  EXPECT_EQ(matrix.GetCapacity(), capacity);
+  EXPECT_EQ(matrix(0, 1), 1.0);
+  EXPECT_THROW(matrix(1, 0), std::out_of_range);
+  EXPECT_THROW(matrix.SetRows(0), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, AppendRowGrowsGeometrically) {
+  S21Matrix matrix(1, 3);
+  int reallocations = 0;
+  size_t capacity = matrix.GetCapacity();
+  for (int i = 1; i < 1000; ++i) {
+    matrix.AppendRow({1.0 * i, 2.0 * i, 3.0 * i});
+    if (matrix.GetCapacity() != capacity) {
+      ++reallocations;
+      capacity = matrix.GetCapacity();
+    }
+  }
+  EXPECT_EQ(matrix.GetRows(), 1000);
+  EXPECT_EQ(matrix(999, 2), 2997.0);
+  EXPECT_EQ(matrix(500, 0), 500.0);
+  EXPECT_LE(reallocations, 11);
+  EXPECT_THROW(matrix.AppendRow({1.0}), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, ReserveAndReshape) {
+  S21Matrix matrix(2, 3);
+  matrix.Reserve(100, 3);
+  EXPECT_GE(matrix.GetCapacity(), 300u);
+  size_t capacity = matrix.GetCapacity();
+  for (int i = 0; i < 98; ++i) matrix.AppendRow({1.0, 2.0, 3.0});
+  EXPECT_EQ(matrix.GetCapacity(), capacity);
+
+  matrix.Reshape(50, 6);
+  EXPECT_EQ(matrix.GetRows(), 50);
+  EXPECT_EQ(matrix(1, 3), 1.0);
+  EXPECT_EQ(matrix(1, 5), 3.0);
+  matrix.Reshape(300, 1);
+  EXPECT_EQ(matrix(299, 0), 3.0);
+  EXPECT_EQ(matrix.GetCapacity(), capacity);
+  EXPECT_THROW(matrix.Reshape(7, 7), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, ResizeMovedFrom) {
+  S21Matrix first(2, 2);
+  S21Matrix second(2, 2);
+  S21Matrix third(2, 2);
+  S21Matrix keep_first(std::move(first));
+  S21Matrix keep_second(std::move(second));
+  S21Matrix keep_third(std::move(third));
+
+  first.Reserve(2, 2);
+  EXPECT_EQ(first.GetRows(), 0);
+  EXPECT_GE(first.GetCapacity(), 4u);
+  // Без второго измерения получилась бы матрица 3x0
+  EXPECT_THROW(second.SetRows(3), std::invalid_argument);
+  EXPECT_THROW(second.SetCols(3), std::invalid_argument);
+  EXPECT_EQ(second.GetRows(), 0);
+  // Первая добавленная строка задает число столбцов
+  EXPECT_THROW(third.AppendRow({}), std::invalid_argument);
+  third.AppendRow({1.0, 2.0, 3.0});
+  third.AppendRow({4.0, 5.0, 6.0});
+  EXPECT_EQ(third.GetRows(), 2);
+  EXPECT_EQ(third.GetCols(), 3);
+  EXPECT_EQ(third.Transpose()(2, 1), 6.0);
+  EXPECT_THROW(third.AppendRow({1.0}), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, ResizeDetachesSharedBuffer) {
+  S21Matrix::SetCopyOnWrite(true);
+  S21Matrix original(2, 2);
+  original(0, 0) = 1.0;
+  original.MulNumber(1.0);
+  S21Matrix copy(original);
+  EXPECT_TRUE(copy.IsShared());
+  copy.AppendRow({5.0, 6.0});
+  EXPECT_EQ(original.GetRows(), 2);
+  EXPECT_EQ(copy(2, 1), 6.0);
+  EXPECT_EQ(copy(0, 0), 1.0);
+  S21Matrix::SetCopyOnWrite(false);
+}
+
+// Тесты для планировщика задач и плиточных разложений
+TEST(S21SchedulerTest, RespectsDependencies) {
+  S21TaskScheduler scheduler(3);
+  S21TaskGraph graph;
+  std::vector<int> order;
+  std::mutex mutex;
+  auto record = [&](int id) {
+    return [&, id] {
+      std::lock_guard<std::mutex> lock(mutex);
+      order.push_back(id);
+    };
+  };
+  int first = graph.Add(record(0));
+  std::vector<int> middle;
+  for (int i = 1; i <= 20; ++i) {
+    middle.push_back(graph.Add(record(i)));
+    graph.Depend(first, middle.back());
+  }
+  int last = graph.Add(record(21), true);
+  for (int task : middle) graph.Depend(task, last);
+
+  scheduler.Run(graph, 3);
+  ASSERT_EQ(order.size(), 22u);
+  EXPECT_EQ(order.front(), 0);
+  EXPECT_EQ(order.back(), 21);
+}
+
+TEST(S21SchedulerTest, PropagatesExceptions) {
+  S21TaskScheduler scheduler(2);
+  S21TaskGraph graph;
+  graph.Add([] { throw std::runtime_error("task failed"); });
+  graph.Add([] {});
+  EXPECT_THROW(scheduler.Run(graph, 2), std::runtime_error);
+}
+
+// Потоки без задач спят, пока одна задача выполняется долго
+TEST(S21SchedulerTest, IdleParticipantsSleep) {
+  S21TaskScheduler scheduler(4);
+  S21TaskGraph graph;
+  int panel = graph.Add(
+      [] { std::this_thread::sleep_for(std::chrono::milliseconds(300)); });
+  std::atomic<int> done{0};
+  for (int i = 0; i < 8; ++i) graph.Depend(panel, graph.Add([&] { ++done; }));
+
+  std::clock_t start = std::clock();
+  scheduler.Run(graph, 4);
+  double cpu = static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+  EXPECT_EQ(done.load(), 8);
+  EXPECT_LT(cpu, 0.1);
+}
+
+TEST(S21TiledTest, LuMatchesProduct) {
+  const int n = 37;
+  std::vector<double> a(n * n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) a[i * n + j] = ((i * 13 + j * 7) % 17) - 8.0;
+  }
+  std::vector<double> lu = a;
+  std::vector<int> perm(n);
+  int sign = S21TiledLu(lu.data(), n, perm.data(), 8, 3);
+  EXPECT_TRUE(sign == 1 || sign == -1);
+
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double sum = 0.0;
+      for (int k = 0; k <= std::min(i, j); ++k) {
+        double l = (k == i) ? 1.0 : lu[i * n + k];
+        sum += l * lu[k * n + j];
+      }
+      EXPECT_NEAR(sum, a[perm[i] * n + j], 1e-9);
+    }
+  }
+}
+
+TEST(S21TiledTest, CholeskyMatchesProduct) {
+  const int n = 29;
+  std::vector<double> a(n * n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a[i * n + j] = (i == j) ? n : 1.0 / (1 + i + j);
+    }
+  }
+  std::vector<double> l = a;
+  ASSERT_TRUE(S21TiledCholesky(l.data(), n, 6, 2));
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j <= i; ++j) {
+      double sum = 0.0;
+      for (int k = 0; k <= j; ++k) sum += l[i * n + k] * l[j * n + k];
+      EXPECT_NEAR(sum, a[i * n + j], 1e-9);
+    }
+  }
+
+  a[0] = -1.0;
+  EXPECT_FALSE(S21TiledCholesky(a.data(), n, 6, 2));
+}
+
+TEST(S21TiledTest, LargeDeterminantAndInverse) {
+  const int n = 300;
+  S21Matrix matrix(n, n);
+  double expected = 1.0;
+  for (int i = 0; i < n; ++i) {
+    // Permuted diagonal: det = sign * product of entries.
+    matrix((i + 1) % n, i) = 1.0 + (i % 3) * 0.5;
+    expected *= 1.0 + (i % 3) * 0.5;
+  }
+  // Циклический сдвиг четной длины - нечетная перестановка
+  expected = -expected;
+  EXPECT_NEAR(matrix.Determinant() / expected, 1.0, 1e-9);
+
+  S21Matrix dense(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      dense(i, j) = (i == j) ? 4.0 : ((i * 31 + j * 17) % 13) / 130.0;
+    }
+  }
+  S21Matrix product = dense * dense.InverseMatrix();
+  for (int i = 0; i < n; i += 37) {
+    for (int j = 0; j < n; j += 41) {
+      EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-9);
+    }
+  }
+
+  S21SymmetricMatrix symmetric(n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j <= i; ++j) symmetric.At(i, j) = dense(i, j);
+  }
+  EXPECT_NEAR(symmetric.Determinant() / symmetric.ToMatrix().Determinant(),
+              1.0, 1e-9);
+}
+
+// Определитель больших хорошо обусловленных матриц уходит в ноль, но они
+// обратимы
+TEST(S21TiledTest, InverseOfScaledIdentity) {
+  const int sizes[] = {3, 300};
+  for (int n : sizes) {
+    S21Matrix matrix(n, n);
+    for (int i = 0; i < n; ++i) matrix(i, i) = 1e-3;
+    S21Matrix inverse = matrix.InverseMatrix();
+    for (int i = 0; i < n; i += 7) {
+      for (int j = 0; j < n; j += 5) {
+        EXPECT_NEAR(inverse(i, j), i == j ? 1e3 : 0.0, 1e-9);
+      }
+    }
+  }
+}
+
+// Тесты для Power и Exp
+TEST(S21MatrixTest, PowerMatchesRepeatedMultiplication) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 1.0;
+  matrix(0, 1) = 0.5;
+  matrix(1, 1) = -1.0;
+  matrix(1, 2) = 0.25;
+  matrix(2, 0) = 0.125;
+  matrix(2, 2) = 0.75;
+  for (int k = 1; k <= 13; ++k) {
+    S21Matrix expected(matrix);
+    for (int i = 1; i < k; ++i) expected *= matrix;
+    S21Matrix result = matrix.Power(k);
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        EXPECT_NEAR(result(i, j), expected(i, j), 1e-12);
+      }
+    }
+  }
+
+  S21Matrix identity = matrix.Power(0);
+  S21Matrix product = matrix.Power(-5) * matrix.Power(5);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_DOUBLE_EQ(identity(i, j), i == j ? 1.0 : 0.0);
+      EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-10);
+    }
+  }
+  EXPECT_THROW(S21Matrix(2, 3).Power(2), std::invalid_argument);
+}
+
+TEST(S21MatrixTest, Exp) {
+  S21Matrix diagonal(2, 2);
+  diagonal(0, 0) = 3.0;
+  diagonal(1, 1) = -0.5;
+  S21Matrix result = diagonal.Exp();
+  EXPECT_NEAR(result(0, 0) / std::exp(3.0), 1.0, 1e-13);
+  EXPECT_NEAR(result(1, 1) / std::exp(-0.5), 1.0, 1e-13);
+  EXPECT_NEAR(result(0, 1), 0.0, 1e-13);
+  EXPECT_NEAR(result(1, 0), 0.0, 1e-13);
+
+  // Поворот: exp([[0, -t], [t, 0]]) = [[cos t, -sin t], [sin t, cos t]]
+  S21Matrix rotation(2, 2);
+  rotation(0, 1) = -10.0;
+  rotation(1, 0) = 10.0;
+  result = rotation.Exp();
+  EXPECT_NEAR(result(0, 0), std::cos(10.0), 1e-11);
+  EXPECT_NEAR(result(0, 1), -std::sin(10.0), 1e-11);
+  EXPECT_NEAR(result(1, 0), std::sin(10.0), 1e-11);
+  EXPECT_NEAR(result(1, 1), std::cos(10.0), 1e-11);
+
+  S21Matrix zero(3, 3);
+  result = zero.Exp();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_DOUBLE_EQ(result(i, j), i == j ? 1.0 : 0.0);
+    }
+  }
+  EXPECT_THROW(S21Matrix(3, 2).Exp(), std::invalid_argument);
+
+  // Бесконечная или неопределённая норма не масштабируется
+  S21Matrix infinite(2, 2);
+  infinite(1, 0) = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(infinite.Exp(), std::invalid_argument);
+  S21Matrix undefined(2, 2);
+  undefined(0, 1) = std::nan("");
+  EXPECT_THROW(undefined.Exp(), std::invalid_argument);
+  S21Matrix overflow(2, 2);
+  overflow(0, 0) = std::numeric_limits<double>::max();
+  overflow(0, 1) = std::numeric_limits<double>::max();
+  EXPECT_THROW(overflow.Exp(), std::invalid_argument);
+}
+
+// Тесты для ядер малых размеров
+TEST(S21MatrixTest, SmallKernelsMatchGenericProduct) {
+  const int sizes[][3] = {{1, 1, 1},  {2, 3, 4},   {5, 16, 7},
+                          {16, 16, 16}, {3, 17, 2}, {17, 4, 4}};
+  for (const auto &size : sizes) {
+    S21Matrix a(size[0], size[1]);
+    S21Matrix b(size[1], size[2]);
+    for (int i = 0; i < size[0]; ++i) {
+      for (int j = 0; j < size[1]; ++j) a(i, j) = (i * 7 + j * 3) % 11 - 5.5;
+    }
+    for (int i = 0; i < size[1]; ++i) {
+      for (int j = 0; j < size[2]; ++j) b(i, j) = (i * 5 + j) % 13 / 3.0;
+    }
+    S21Matrix product = a * b;
+    ASSERT_EQ(product.GetRows(), size[0]);
+    ASSERT_EQ(product.GetCols(), size[2]);
+    for (int i = 0; i < size[0]; ++i) {
+      for (int j = 0; j < size[2]; ++j) {
+        double sum = 0.0;
+        for (int k = 0; k < size[1]; ++k) sum += a(i, k) * b(k, j);
+        EXPECT_EQ(product(i, j), sum);
+      }
+    }
+  }
+}
+
+TEST(S21MatrixTest, ClosedFormFourByFour) {
+  S21Matrix matrix(4, 4);
+  const double values[4][4] = {
+      {2, -1, 0, 3}, {1, 4, -2, 0}, {0, 5, 3, -1}, {-3, 0, 1, 2}};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) matrix(i, j) = values[i][j];
+  }
+  EXPECT_DOUBLE_EQ(matrix.Determinant(), 280.0);
+
+  S21Matrix product = matrix * matrix.InverseMatrix();
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      EXPECT_NEAR(product(i, j), i == j ? 1.0 : 0.0, 1e-14);
+    }
+  }
+
+  // Дополнения совпадают со знакопеременными минорами
+  S21Matrix complements = matrix.CalcComplements();
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      double minor = matrix.CalcMinor(i, j).Determinant();
+      EXPECT_DOUBLE_EQ(complements(i, j), (i + j) % 2 == 0 ? minor : -minor);
+    }
+  }
+}
+
+// Тесты для настраиваемых параметров и автонастройки
+TEST(S21MatrixTest, TuningDoesNotChangeResults) {
+  S21TuningParams saved = S21Matrix::GetTuning();
+  S21Matrix a(37, 53);
+  S21Matrix b(53, 29);
+  for (int i = 0; i < 37; ++i) {
+    for (int j = 0; j < 53; ++j) a(i, j) = (i * 13 + j * 7) % 19 / 7.0 - 1.0;
+  }
+  for (int i = 0; i < 53; ++i) {
+    for (int j = 0; j < 29; ++j) b(i, j) = (i * 3 + j * 11) % 23 / 5.0;
+  }
+  S21Matrix product = a * b;
+  S21Matrix transposed = a.Transpose();
+
+  const int blocks[] = {1, 5, 16, 1000};
+  for (int block : blocks) {
+    S21TuningParams params;
+    params.mul_block = block;
+    params.transpose_block = block;
+    params.parallel_work = 0.0;
+    params.elementwise_work = 0.0;
+    S21Matrix::SetTuning(params);
+    EXPECT_EQ(S21Matrix::GetTuning().mul_block, block);
+    S21Matrix tuned = a * b;
+    S21Matrix tuned_transposed = a.Transpose();
+    for (int i = 0; i < 37; ++i) {
+      for (int j = 0; j < 29; ++j) EXPECT_EQ(tuned(i, j), product(i, j));
+      for (int j = 0; j < 53; ++j) {
+        EXPECT_EQ(tuned_transposed(j, i), transposed(j, i));
+      }
+    }
+  }
+  S21TuningParams invalid;
+  invalid.mul_block = 0;
+  EXPECT_THROW(S21Matrix::SetTuning(invalid), std::invalid_argument);
+  S21Matrix::SetTuning(saved);
+}
+
+TEST(S21MatrixTest, AutotunerCache) {
+  S21TuningParams saved = S21Matrix::GetTuning();
+  std::string path = ::testing::TempDir() + "s21_matrix_tune_test";
+  std::remove(path.c_str());
+  EXPECT_FALSE(S21Autotuner::Load(path));
+
+  // Записи других процессоров сохраняются
+  {
+    std::ofstream file(path);
+    file << "other cpu x4\t8 8 1000 2000\n";
+  }
+  S21TuningParams params;
+  params.mul_block = 48;
+  params.transpose_block = 24;
+  params.parallel_work = 1234567.0;
+  params.elementwise_work = 7654321.0;
+  ASSERT_TRUE(S21Autotuner::Save(path, params));
+  ASSERT_TRUE(S21Autotuner::Save(path, params));
+  S21Matrix::SetTuning(S21TuningParams());
+  ASSERT_TRUE(S21Autotuner::Load(path));
+  S21TuningParams loaded = S21Matrix::GetTuning();
+  EXPECT_EQ(loaded.mul_block, 48);
+  EXPECT_EQ(loaded.transpose_block, 24);
+  EXPECT_DOUBLE_EQ(loaded.parallel_work, 1234567.0);
+  EXPECT_DOUBLE_EQ(loaded.elementwise_work, 7654321.0);
+
+  std::ifstream file(path);
+  std::string line;
+  int lines = 0;
+  while (std::getline(file, line)) ++lines;
+  EXPECT_EQ(lines, 2);
+  std::remove(path.c_str());
+
+  S21TuningParams tuned = S21Autotuner::Tune(64);
+  EXPECT_EQ(S21Matrix::GetTuning().mul_block, tuned.mul_block);
+  EXPECT_EQ(S21Matrix::GetTuning().transpose_block, tuned.transpose_block);
+  S21Matrix::SetTuning(saved);
+}
+
+// Одновременные сохранения не делят временный файл
+TEST(S21MatrixTest, AutotunerConcurrentSave) {
+  std::string dir = ::testing::TempDir() + "s21_matrix_tune_race";
+  std::filesystem::remove_all(dir);
+  std::string path = dir + "/cache";
+  std::vector<std::thread> writers;
+  std::atomic<int> saved{0};
+  for (int t = 0; t < 8; ++t) {
+    writers.emplace_back([&path, &saved, t] {
+      S21TuningParams params;
+      params.mul_block = 16 + t;
+      for (int i = 0; i < 20; ++i) {
+        if (S21Autotuner::Save(path, params)) ++saved;
+      }
+    });
+  }
+  for (std::thread& writer : writers) writer.join();
+  EXPECT_EQ(saved.load(), 160);
+
+  std::ifstream file(path);
+  std::string line;
+  int lines = 0;
+  while (std::getline(file, line)) ++lines;
+  EXPECT_EQ(lines, 1);
+  int entries = 0;
+  for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+    (void)entry;
+    ++entries;
+  }
+  EXPECT_EQ(entries, 1);
+  std::filesystem::remove_all(dir);
+}
+
+// Тесты для текстового ввода-вывода
+TEST(S21MatrixTest, CsvRoundTrip) {
+  S21Matrix matrix(7, 5);
+  for (int i = 0; i < 7; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      matrix(i, j) = std::ldexp(1.0 + i * 0.1234567890123, j * 40 - 90) *
+                     ((i + j) % 2 == 0 ? 1 : -1) / 3.0;
+    }
+  }
+  matrix(0, 0) = 0.1;
+  matrix(6, 4) = -0.0;
+
+  std::string path = ::testing::TempDir() + "s21_matrix_io_test";
+  matrix.ToCsv(path);
+  S21Matrix csv = S21Matrix::FromCsv(path);
+  matrix.ToText(path);
+  S21Matrix text = S21Matrix::FromText(path);
+  matrix.ToCsv(path, ';');
+  S21Matrix semicolon = S21Matrix::FromCsv(path, ';');
+  matrix.ToCsv(path, '\t');
+  S21Matrix tsv = S21Matrix::FromCsv(path, '\t');
+  std::remove(path.c_str());
+
+  for (const S21Matrix *loaded : {&csv, &text, &semicolon, &tsv}) {
+    ASSERT_EQ(loaded->GetRows(), 7);
+    ASSERT_EQ(loaded->GetCols(), 5);
+    for (int i = 0; i < 7; ++i) {
+      for (int j = 0; j < 5; ++j) EXPECT_EQ((*loaded)(i, j), matrix(i, j));
+    }
+  }
+  EXPECT_TRUE(std::signbit(csv(6, 4)));
+}
+
+TEST(S21MatrixTest, CsvParsing) {
+  std::string path = ::testing::TempDir() + "s21_matrix_io_test";
+  auto write = [&](const char *text) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << text;
+  };
+
+  write("1, 2,3\r\n\n +4,5e-1 ,-6\r\n\n");
+  S21Matrix csv = S21Matrix::FromCsv(path);
+  ASSERT_EQ(csv.GetRows(), 2);
+  ASSERT_EQ(csv.GetCols(), 3);
+  EXPECT_EQ(csv(1, 0), 4.0);
+  EXPECT_EQ(csv(1, 1), 0.5);
+  EXPECT_EQ(csv(1, 2), -6.0);
+
+  write("  1\t2   3\n4 5 6");
+  S21Matrix text = S21Matrix::FromText(path);
+  ASSERT_EQ(text.GetRows(), 2);
+  EXPECT_EQ(text(0, 1), 2.0);
+  EXPECT_EQ(text(1, 2), 6.0);
+
+  write("1,2\n3\n");
+  EXPECT_THROW(S21Matrix::FromCsv(path), std::invalid_argument);
+  write("1,x\n");
+  EXPECT_THROW(S21Matrix::FromCsv(path), std::invalid_argument);
+  write("1,2,\n");
+  EXPECT_THROW(S21Matrix::FromCsv(path), std::invalid_argument);
+  // Табуляция-разделитель не пропускается как пробел
+  write("1\t 2\r\n3\t4\n");
+  EXPECT_EQ(S21Matrix::FromCsv(path, '\t')(1, 1), 4.0);
+  write("1\t\t2\n");
+  EXPECT_THROW(S21Matrix::FromCsv(path, '\t'), std::invalid_argument);
+  write("\n \n");
+  EXPECT_THROW(S21Matrix::FromCsv(path), std::invalid_argument);
+  std::remove(path.c_str());
+  EXPECT_THROW(S21Matrix::FromCsv(path), std::runtime_error);
+}
+
+TEST(S21MatrixTest, CsvLargeParallel) {
+  S21Matrix::SetMaxThreads(4);
+  const int rows = 2000, cols = 60;
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) matrix(i, j) = (i * 7919.0 + j) / 977.0;
+  }
+  std::string path = ::testing::TempDir() + "s21_matrix_io_test";
+  matrix.ToCsv(path);
+  S21Matrix loaded = S21Matrix::FromCsv(path);
+  std::remove(path.c_str());
+  S21Matrix::SetMaxThreads(0);
+
+  ASSERT_EQ(loaded.GetRows(), rows);
+  ASSERT_EQ(loaded.GetCols(), cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) ASSERT_EQ(loaded(i, j), matrix(i, j));
+  }
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
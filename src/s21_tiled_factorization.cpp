@@ -0,0 +1,215 @@
+#include "s21_tiled_factorization.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "s21_task_scheduler.h"
+
+namespace {
+
+struct Tiling {
+  int n, tile, count;
+  int Begin(int t) const { return t * tile; }
+  int End(int t) const { return std::min(n, (t + 1) * tile); }
+};
+
+// Unblocked LU of the column panel k, rows [Begin(k), n). Row swaps are
+// applied to the panel columns only; pivots[r] is the row swapped with r.
+void FactorPanel(double *a, const Tiling &t, int k, int *pivots) {
+  const int n = t.n;
+  const int c0 = t.Begin(k), c1 = t.End(k);
+  for (int c = c0; c < c1; ++c) {
+    int pivot = c;
+    for (int r = c + 1; r < n; ++r) {
+      if (std::fabs(a[r * n + c]) > std::fabs(a[pivot * n + c])) pivot = r;
+    }
+    pivots[c] = pivot;
+    if (pivot != c) {
+      std::swap_ranges(a + c * n + c0, a + c * n + c1, a + pivot * n + c0);
+    }
+    const double diag = a[c * n + c];
+    if (diag == 0.0) continue;
+    for (int r = c + 1; r < n; ++r) {
+      double factor = a[r * n + c] / diag;
+      a[r * n + c] = factor;
+      for (int j = c + 1; j < c1; ++j) a[r * n + j] -= factor * a[c * n + j];
+    }
+  }
+}
+
+// Applies the swaps of step k to column tile j and solves for U(k, j).
+void SwapAndSolve(double *a, const Tiling &t, int k, int j,
+                  const int *pivots) {
+  const int n = t.n;
+  const int r0 = t.Begin(k), r1 = t.End(k);
+  const int c0 = t.Begin(j), c1 = t.End(j);
+  for (int r = r0; r < r1; ++r) {
+    if (pivots[r] != r) {
+      std::swap_ranges(a + r * n + c0, a + r * n + c1, a + pivots[r] * n + c0);
+    }
+  }
+  for (int r = r0; r < r1; ++r) {
+    for (int s = r0; s < r; ++s) {
+      double l = a[r * n + s];
+      for (int c = c0; c < c1; ++c) a[r * n + c] -= l * a[s * n + c];
+    }
+  }
+}
+
+// A(i, j) -= L(i, k) * U(k, j)
+void UpdateLu(double *a, const Tiling &t, int k, int i, int j) {
+  const int n = t.n;
+  for (int r = t.Begin(i); r < t.End(i); ++r) {
+    for (int s = t.Begin(k); s < t.End(k); ++s) {
+      double l = a[r * n + s];
+      for (int c = t.Begin(j); c < t.End(j); ++c) {
+        a[r * n + c] -= l * a[s * n + c];
+      }
+    }
+  }
+}
+
+// Cholesky of the diagonal tile k.
+bool FactorDiagonal(double *a, const Tiling &t, int k) {
+  const int n = t.n;
+  const int b0 = t.Begin(k), b1 = t.End(k);
+  for (int j = b0; j < b1; ++j) {
+    double diag = a[j * n + j];
+    for (int s = b0; s < j; ++s) diag -= a[j * n + s] * a[j * n + s];
+    if (diag <= 0.0) return false;
+    diag = std::sqrt(diag);
+    a[j * n + j] = diag;
+    for (int r = j + 1; r < b1; ++r) {
+      double sum = a[r * n + j];
+      for (int s = b0; s < j; ++s) sum -= a[r * n + s] * a[j * n + s];
+      a[r * n + j] = sum / diag;
+    }
+  }
+  return true;
+}
+
+// L(i, k) = A(i, k) * L(k, k)^-T
+void SolveCholesky(double *a, const Tiling &t, int k, int i) {
+  const int n = t.n;
+  const int b0 = t.Begin(k), b1 = t.End(k);
+  for (int r = t.Begin(i); r < t.End(i); ++r) {
+    for (int c = b0; c < b1; ++c) {
+      double sum = a[r * n + c];
+      for (int s = b0; s < c; ++s) sum -= a[r * n + s] * a[c * n + s];
+      a[r * n + c] = sum / a[c * n + c];
+    }
+  }
+}
+
+// A(i, j) -= L(i, k) * L(j, k)^T, lower triangle only when i == j.
+void UpdateCholesky(double *a, const Tiling &t, int k, int i, int j) {
+  const int n = t.n;
+  for (int r = t.Begin(i); r < t.End(i); ++r) {
+    int c_end = (i == j) ? r + 1 : t.End(j);
+    for (int c = t.Begin(j); c < c_end; ++c) {
+      double sum = 0.0;
+      for (int s = t.Begin(k); s < t.End(k); ++s) {
+        sum += a[r * n + s] * a[c * n + s];
+      }
+      a[r * n + c] -= sum;
+    }
+  }
+}
+
+}  // namespace
+
+int S21TiledLu(double *a, int n, int *perm, int tile, int threads) {
+  Tiling t{n, tile, (n + tile - 1) / tile};
+  std::vector<int> pivots(n);
+  S21TaskGraph graph;
+
+  // last[i * count + j] is the task that last wrote tile (i, j).
+  std::vector<int> last(static_cast<size_t>(t.count) * t.count, -1);
+  auto tile_id = [&](int i, int j) -> int & { return last[i * t.count + j]; };
+
+  for (int k = 0; k < t.count; ++k) {
+    int panel = graph.Add([=, &pivots] { FactorPanel(a, t, k, pivots.data()); },
+                          true);
+    for (int i = k; i < t.count; ++i) {
+      if (tile_id(i, k) >= 0) graph.Depend(tile_id(i, k), panel);
+    }
+    for (int i = k; i < t.count; ++i) tile_id(i, k) = panel;
+
+    for (int j = k + 1; j < t.count; ++j) {
+      // The column right after the panel feeds the next panel (lookahead).
+      bool urgent = (j == k + 1);
+      int solve = graph.Add(
+          [=, &pivots] { SwapAndSolve(a, t, k, j, pivots.data()); }, urgent);
+      graph.Depend(panel, solve);
+      for (int i = k; i < t.count; ++i) {
+        if (tile_id(i, j) >= 0) graph.Depend(tile_id(i, j), solve);
+      }
+      for (int i = k; i < t.count; ++i) tile_id(i, j) = solve;
+
+      for (int i = k + 1; i < t.count; ++i) {
+        int update = graph.Add([=] { UpdateLu(a, t, k, i, j); }, urgent);
+        graph.Depend(solve, update);
+        tile_id(i, j) = update;
+      }
+    }
+  }
+  S21TaskScheduler::Instance().Run(graph, threads);
+
+  // Swaps of later steps reach the finished L columns only now, so that
+  // no update ever reads rows of L that were moved under it.
+  int sign = 1;
+  for (int i = 0; i < n; ++i) perm[i] = i;
+  for (int k = 0; k < t.count; ++k) {
+    for (int r = t.Begin(k); r < t.End(k); ++r) {
+      int p = pivots[r];
+      if (p == r) continue;
+      std::swap_ranges(a + r * n, a + r * n + t.Begin(k), a + p * n);
+      std::swap(perm[r], perm[p]);
+      sign = -sign;
+    }
+  }
+  return sign;
+}
+
+bool S21TiledCholesky(double *a, int n, int tile, int threads) {
+  Tiling t{n, tile, (n + tile - 1) / tile};
+  std::atomic<bool> definite{true};
+  S21TaskGraph graph;
+
+  std::vector<int> last(static_cast<size_t>(t.count) * t.count, -1);
+  auto tile_id = [&](int i, int j) -> int & { return last[i * t.count + j]; };
+  auto after = [&](int task, int i, int j) {
+    if (tile_id(i, j) >= 0) graph.Depend(tile_id(i, j), task);
+    tile_id(i, j) = task;
+  };
+
+  for (int k = 0; k < t.count; ++k) {
+    int diag = graph.Add(
+        [=, &definite] {
+          if (!FactorDiagonal(a, t, k)) definite = false;
+        },
+        true);
+    after(diag, k, k);
+
+    std::vector<int> solves(t.count, -1);
+    for (int i = k + 1; i < t.count; ++i) {
+      solves[i] = graph.Add([=] { SolveCholesky(a, t, k, i); }, i == k + 1);
+      graph.Depend(diag, solves[i]);
+      after(solves[i], i, k);
+    }
+    for (int i = k + 1; i < t.count; ++i) {
+      for (int j = k + 1; j <= i; ++j) {
+        int update =
+            graph.Add([=] { UpdateCholesky(a, t, k, i, j); }, j == k + 1);
+        graph.Depend(solves[i], update);
+        if (j != i) graph.Depend(solves[j], update);
+        after(update, i, j);
+      }
+    }
+  }
+  S21TaskScheduler::Instance().Run(graph, threads);
+  return definite;
+}
@@ -0,0 +1,17 @@
+#ifndef S21_TILED_FACTORIZATION_H
+#define S21_TILED_FACTORIZATION_H
+
+// Плиточные разложения для больших матриц. Матрица n x n хранится по
+// строкам в a и заменяется результатом. Шаги разложения (панель,
+// треугольные решения, обновления остатка) выполняются как граф задач
+// в S21TaskScheduler, следующая панель считается с опережением.
+
+// LU-разложение с выбором ведущего элемента по столбцу, PA = LU.
+// perm[i] - исходный номер i-й строки PA. Возвращает знак перестановки.
+int S21TiledLu(double *a, int n, int *perm, int tile, int threads);
+
+// Разложение Холецкого A = L * L^T по нижнему треугольнику a.
+// Возвращает false, если матрица не положительно определена.
+bool S21TiledCholesky(double *a, int n, int tile, int threads);
+
+#endif  // S21_TILED_FACTORIZATION_H